@@ -1,3 +1,4 @@
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <pthread.h>
@@ -6,6 +7,24 @@
 #include <time.h>
 #include <sys/time.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <limits.h>
+
+// camada de sincronização: 1 = spin seguido de futex (Linux), 0 = somente pthread
+#ifndef SINCRONIZACAO_FUTEX
+#ifdef __linux__
+#define SINCRONIZACAO_FUTEX 1
+#else
+#define SINCRONIZACAO_FUTEX 0
+#endif
+#endif
+
+#if SINCRONIZACAO_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
 
 // configurações do aeroporto
 #define NUM_PISTAS 3
@@ -16,6 +35,49 @@
 #define TEMPO_QUEDA 90       // 90 segundos para queda
 #define MAX_TENTATIVAS 10    // máximo de tentativas antes de arremeter
 
+// duração das operações em segundos
+#define TEMPO_POUSO 2
+#define TEMPO_DESEMBARQUE 3
+#define TEMPO_DECOLAGEM 2
+
+// controle de admissão e circuito de espera (holding)
+#define LIMITE_FILA_ADMISSAO 4       // requisições na fila a partir das quais chegadas vão para o circuito
+#define LIMITE_OCUPACAO_ADMISSAO 80  // ocupação dos recursos (%) a partir da qual chegadas vão para o circuito
+#define MAX_CIRCUITO_ESPERA 6        // máximo de aviões simultâneos no circuito de espera
+#define TEMPO_VOLTA_CIRCUITO 5       // duração de uma volta no circuito em segundos
+#define MAX_VOLTAS_CIRCUITO 8        // voltas antes de desviar para um aeroporto alternativo
+
+// planejador de reservas de slots (pista, portão e torre)
+#define SLOT_PLANEJAMENTO_MS 250     // granularidade dos slots
+#define HORIZONTE_PLANEJAMENTO 60    // segundos à frente em que o planejador procura slots
+#define FOLGA_ENTRE_FASES_MS 2000    // espera máxima planejada entre uma fase e a seguinte
+#define TOLERANCIA_ATRASO_MS 500     // atraso tolerado em relação à reserva antes de replanejar
+#define MAX_RESERVAS 3000
+
+// checkpoint do estado da simulação
+#define CHECKPOINT_MAGICO "ATCK"
+#define CHECKPOINT_VERSAO 2
+#define TAMANHO_CABECALHO_V1 120          // versão 1: sem o estado de capacidade
+#define CHECKPOINT_ORDEM_BYTES 0x01020304u  // detecta arquivos gravados com outra ordem de bytes
+
+// espera por recursos
+#define TEMPO_ESPERA_RECURSOS_MS 2000  // prazo de cada espera antes de uma nova tentativa
+#define SPIN_ITERACOES 2000            // iterações de spin antes de estacionar no futex
+
+// eventos de capacidade em tempo de execução
+#define MAX_EVENTOS 256
+#define MAX_CAPACIDADE_TORRE 64        // maior capacidade da torre aceita (evita overflow nas contas de ocupação)
+#define MAX_SEGUNDOS_VAZAO 7200        // histórico de operações concluídas por segundo
+#define JANELA_VAZAO 30                // segundos de referência antes de um evento
+#define JANELA_RECUPERACAO 10          // janela móvel para medir a vazão após um evento
+#define LIMIAR_RECUPERACAO 90          // % da vazão anterior que caracteriza a recuperação
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PAUSA_CPU() __builtin_ia32_pause()
+#else
+#define PAUSA_CPU() do { } while (0)
+#endif
+
 // estados do avião
 typedef enum {
     AGUARDANDO_POUSO,
@@ -26,7 +88,9 @@ typedef enum {
     DECOLANDO,
     FINALIZADO,
     CAIU,
-    ARREMETEU
+    ARREMETEU,
+    EM_CIRCUITO,
+    DESVIADO
 } estado_aviao_t;
 
 // tipos de voo
@@ -35,6 +99,48 @@ typedef enum {
     INTERNACIONAL
 } tipo_voo_t;
 
+// fases de operação de um avião
+typedef enum {
+    FASE_POUSO,
+    FASE_DESEMBARQUE,
+    FASE_DECOLAGEM,
+    NUM_FASES
+} fase_t;
+
+// tipos de recurso reservável
+typedef enum {
+    RECURSO_PISTA,
+    RECURSO_PORTAO,
+    RECURSO_TORRE
+} tipo_recurso_t;
+
+// evento de capacidade aplicado durante a simulação
+typedef struct {
+    long long instante_ms;
+    long long aplicacao_us;   // tempo para aplicar o evento (inclui replanejamento)
+    int voos_afetados;        // voos ocupando o recurso no momento do evento
+    int voos_replanejados;
+    char descricao[64];
+} evento_capacidade_t;
+
+// estrutura de reserva de um recurso em uma janela de tempo
+typedef struct {
+    int aviao_id;
+    fase_t fase;
+    tipo_recurso_t recurso;
+    int indice;
+    long long inicio_ms;
+    long long fim_ms;
+} reserva_t;
+
+// plano de reservas de um avião para pouso, desembarque e decolagem
+typedef struct {
+    int valido;
+    long long inicio_ms[NUM_FASES];
+    int pista[NUM_FASES];
+    int portao;
+} plano_voo_t;
+
 // estrutura para requisição de recursos
 typedef struct {
     int aviao_id;
@@ -42,6 +148,8 @@ typedef struct {
     int tentativas;
     struct timeval timestamp;
     pthread_cond_t cond;
+    atomic_uint despertar;      // palavra de futex própria: só a primeira da fila é acordada
+    atomic_int estacionada;     // a thread dorme no futex de despertar
     int recursos_alocados;
     int pista_alocada;
     int portao_alocado;
@@ -62,8 +170,87 @@ typedef struct {
     int em_estado_critico;
     int prioridade;
     int tentativas_totais;
+    int passou_circuito;
+    int voltas_circuito;
+    int liberado_circuito;               // liberado do circuito e ainda sem a pista de pouso
+    long long chegada_ms;
+    long long inicio_portao_ms;
+    long long inicio_operacao_ms;
+    plano_voo_t plano;
+    int retomado;                        // restaurado de um checkpoint e ainda não retomado
+    int requisicao_restaurada;           // tinha requisição na fila no checkpoint
+    struct timeval timestamp_requisicao;
 } aviao_t;
 
+// cabeçalho do arquivo de checkpoint (campos de 64 bits primeiro, sem padding)
+typedef struct {
+    char magico[4];
+    uint32_t versao;
+    int64_t tempo_decorrido_ms;
+    int64_t tempo_pistas_ocupadas_ms;
+    int64_t tempo_portoes_ocupados_ms;
+    int64_t soma_tempo_atendimento_ms;
+    int64_t soma_latencia_despertar_us;
+    uint32_t ordem_bytes;
+    uint32_t estado_rng;
+    int32_t num_pistas;
+    int32_t num_portoes;
+    int32_t max_torre_operacoes;
+    int32_t proximo_id;
+    int32_t total_avioes_criados;
+    int32_t avioes_finalizados;
+    int32_t avioes_caidos;
+    int32_t avioes_arremetidos;
+    int32_t starvation_cases;
+    int32_t avioes_circuito_total;
+    int32_t avioes_desviados;
+    int32_t replanejamentos;
+    int32_t voos_sem_plano;
+    int32_t despertares_por_liberacao;
+    int32_t num_avioes;
+    int32_t num_requisicoes;
+    // versão 2: estado de capacidade alterado por eventos
+    uint32_t pistas_fechadas;   // bit i = pista i fechada
+    uint32_t portoes_fechados;  // bit i = portão i fechado
+    int32_t capacidade_torre;
+    int32_t reservado;
+} cabecalho_checkpoint_t;
+
+// registro de um avião no checkpoint (tempos relativos ao instante do checkpoint)
+typedef struct {
+    int32_t id;
+    int32_t prioridade;
+    int32_t tentativas_totais;
+    int32_t tempo_espera_total;
+    int32_t espera_ms;
+    int32_t desde_chegada_ms;
+    int32_t desde_portao_ms;
+    int32_t desde_operacao_ms;
+    int8_t tipo;
+    int8_t estado;
+    int8_t operacoes_concluidas;
+    int8_t pista_alocada;
+    int8_t portao_alocado;
+    int8_t em_estado_critico;
+    int8_t passou_circuito;
+    int8_t voltas_circuito;
+} registro_aviao_t;
+
+// registro de uma requisição da fila no checkpoint
+typedef struct {
+    int32_t aviao_id;
+    int32_t prioridade;
+    int32_t tentativas;
+    int32_t idade_ms;
+} registro_requisicao_t;
+
+// o formato do arquivo depende destes tamanhos: mudá-los exige nova CHECKPOINT_VERSAO
+_Static_assert(sizeof(cabecalho_checkpoint_t) == TAMANHO_CABECALHO_V1 + 16, "cabeçalho de checkpoint mudou de tamanho");
+_Static_assert(NUM_PISTAS <= 32 && NUM_PORTOES <= 32, "máscaras de recursos fechados no checkpoint têm 32 bits");
+_Static_assert(MAX_TORRE_OPERACOES <= MAX_CAPACIDADE_TORRE, "capacidade padrão da torre acima do limite aceito");
+_Static_assert(sizeof(registro_aviao_t) == 40, "registro de avião mudou de tamanho");
+_Static_assert(sizeof(registro_requisicao_t) == 16, "registro de requisição mudou de tamanho");
+
 // recursos do aeroporto
 sem_t pistas[NUM_PISTAS];
 sem_t portoes[NUM_PORTOES];
@@ -71,13 +258,26 @@ sem_t portoes[NUM_PORTOES];
 // sistema de controle da torre com prioridade
 pthread_mutex_t mutex_torre = PTHREAD_MUTEX_INITIALIZER;
 pthread_cond_t cond_torre = PTHREAD_COND_INITIALIZER;
-int torre_livre = MAX_TORRE_OPERACOES;
+atomic_int torre_livre = MAX_TORRE_OPERACOES;  // recurso de contagem, sem depender de mutex_recursos
+
+// capacidade alterável em tempo de execução (eventos); lida sem mutex_recursos
+atomic_int pista_fechada[NUM_PISTAS];
+atomic_int portao_fechado[NUM_PORTOES];
+atomic_int capacidade_torre = MAX_TORRE_OPERACOES;
 int esperando_critico = 0;
 
 // sistema de alocação de recursos com prioridade
 pthread_mutex_t mutex_recursos = PTHREAD_MUTEX_INITIALIZER;
 pthread_cond_t cond_recursos = PTHREAD_COND_INITIALIZER;
 
+// espera por recursos com spin + futex (alternativa a cond_recursos, a linha de base pthread)
+// requisições da fila esperam na palavra da própria requisição; a palavra global fica para os
+// aviões do planejador esperando os recursos da reserva
+atomic_uint geracao_recursos = 0;       // incrementada a cada liberação de recursos
+atomic_int esperando_recursos = 0;      // threads de reserva estacionadas no futex global
+atomic_llong ultima_liberacao_us = 0;   // instante da última liberação (latência de despertar)
+int sincronizacao_futex = SINCRONIZACAO_FUTEX;
+
 // fila de prioridades para requisições
 #define MAX_REQUISICOES 1000
 requisicao_t* fila_requisicoes[MAX_REQUISICOES];
@@ -88,9 +288,25 @@ pthread_mutex_t mutex_print = PTHREAD_MUTEX_INITIALIZER;
 pthread_mutex_t mutex_stats = PTHREAD_MUTEX_INITIALIZER;
 pthread_mutex_t mutex_critico = PTHREAD_MUTEX_INITIALIZER;
 
+// controle de admissão (circuito de espera)
+pthread_mutex_t mutex_admissao = PTHREAD_MUTEX_INITIALIZER;
+int avioes_em_circuito = 0;
+int liberacoes_pendentes = 0;  // aviões liberados do circuito que ainda não chegaram à fila ou à pista
+
+// planejador de reservas
+pthread_mutex_t mutex_planejador = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t cond_planejador = PTHREAD_COND_INITIALIZER;
+reserva_t reservas[MAX_RESERVAS];
+int num_reservas = 0;
+int planejador_ativo = 0;
+
 // controle da simulação
 volatile int simulacao_ativa = 1;
+long long inicio_simulacao_ms = 0;
 volatile int proximo_id = 1;
+unsigned int estado_rng = 0;  // estado do gerador de chegadas (rand_r), salvo no checkpoint
+int duracao_simulacao = TEMPO_SIMULACAO;
+long long inicio_execucao_ms = 0;  // início desta execução (referência dos eventos e da vazão)
 
 // estatísticas
 int total_avioes_criados = 0;
@@ -99,10 +315,23 @@ int avioes_caidos = 0;
 int avioes_arremetidos = 0;
 int deadlocks_detectados = 0;
 int starvation_cases = 0;
-
-// lista de aviões para monitoramento
-aviao_t *avioes[1000];
+int avioes_circuito_total = 0;
+int avioes_desviados = 0;
+int replanejamentos = 0;
+int voos_sem_plano = 0;
+long long tempo_pistas_ocupadas_ms = 0;
+long long tempo_portoes_ocupados_ms = 0;
+long long soma_tempo_atendimento_ms = 0;
+long long soma_latencia_despertar_us = 0;
+int despertares_por_liberacao = 0;
+int operacoes_por_segundo[MAX_SEGUNDOS_VAZAO];
+evento_capacidade_t eventos[MAX_EVENTOS];
+int num_eventos = 0;
+
+// lista de aviões para monitoramento (cresce sob demanda)
+aviao_t **avioes = NULL;
 int num_avioes = 0;
+int capacidade_avioes = 0;
 pthread_mutex_t mutex_avioes = PTHREAD_MUTEX_INITIALIZER;
 
 // função para obter tempo atual em ms
@@ -112,6 +341,21 @@ long long get_time_ms() {
     return (long long)tv.tv_sec * 1000 + tv.tv_usec / 1000;
 }
 
+// função para obter tempo atual em µs
+long long get_time_us() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (long long)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+// função para converter um instante em ms para timespec (prazo de pthread_cond_timedwait)
+struct timespec ms_para_timespec(long long ms) {
+    struct timespec ts;
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (ms % 1000) * 1000000;
+    return ts;
+}
+
 // função para print thread-safe
 void safe_print(const char* format, ...) {
     pthread_mutex_lock(&mutex_print);
@@ -221,6 +465,174 @@ void resetar_cronometro(aviao_t *aviao) {
     aviao->em_estado_critico = 0;
 }
 
+// função para incluir um avião na lista de monitoramento (chamar com mutex_avioes travado)
+void adicionar_aviao(aviao_t *aviao) {
+    if (num_avioes == capacidade_avioes) {
+        capacidade_avioes = (capacidade_avioes > 0) ? capacidade_avioes * 2 : 1024;
+        avioes = realloc(avioes, capacidade_avioes * sizeof(aviao_t*));
+    }
+    avioes[num_avioes++] = aviao;
+}
+
+// função para mudar o estado do avião junto com os recursos que ele ocupa
+// (sob mutex_avioes, para o checkpoint sempre ver estado e recursos coerentes)
+void transicao_aviao(aviao_t *aviao, estado_aviao_t estado, int pista, int portao) {
+    pthread_mutex_lock(&mutex_avioes);
+    aviao->estado = estado;
+    aviao->pista_alocada = pista;
+    aviao->portao_alocado = portao;
+    aviao->inicio_operacao_ms = get_time_ms();
+    pthread_mutex_unlock(&mutex_avioes);
+}
+
+// função para encerrar uma operação: estado seguinte, recursos mantidos e contador no mesmo passo
+// (chamar antes de liberar os recursos, para o checkpoint nunca ver um recurso livre como ocupado)
+void concluir_operacao(aviao_t *aviao, estado_aviao_t estado, int pista, int portao) {
+    pthread_mutex_lock(&mutex_avioes);
+    aviao->estado = estado;
+    aviao->pista_alocada = pista;
+    aviao->portao_alocado = portao;
+    aviao->operacoes_concluidas++;
+    aviao->inicio_operacao_ms = get_time_ms();
+    pthread_mutex_unlock(&mutex_avioes);
+}
+
+// função para aguardar o restante de uma operação iniciada em inicio_operacao_ms
+void aguardar_operacao(aviao_t *aviao, int duracao_segundos) {
+    long long restante_ms = duracao_segundos * 1000LL - (get_time_ms() - aviao->inicio_operacao_ms);
+    if (restante_ms > 0) {
+        struct timespec ts;
+        ts.tv_sec = restante_ms / 1000;
+        ts.tv_nsec = (restante_ms % 1000) * 1000000;
+        nanosleep(&ts, NULL);
+    }
+}
+
+// função para verificar se o avião já encerrou sua participação na simulação
+int estado_terminal(estado_aviao_t estado) {
+    return estado == FINALIZADO || estado == CAIU || estado == ARREMETEU || estado == DESVIADO;
+}
+
+// função para tentar ocupar uma operação da torre sem bloquear
+int torre_tentar_adquirir() {
+    int livre = atomic_load(&torre_livre);
+    while (livre > 0) {
+        if (atomic_compare_exchange_weak(&torre_livre, &livre, livre - 1)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// função para devolver uma operação da torre
+void torre_liberar() {
+    atomic_fetch_add(&torre_livre, 1);
+}
+
+// função para registrar a latência entre a liberação de recursos e o despertar de quem esperava
+// (só conta se houve liberação durante a espera; despertares por troca da primeira da fila não contam)
+void registrar_latencia_despertar(long long inicio_espera_us) {
+    long long liberacao_us = atomic_load(&ultima_liberacao_us);
+    if (liberacao_us < inicio_espera_us) return;
+
+    long long latencia = get_time_us() - liberacao_us;
+
+    pthread_mutex_lock(&mutex_stats);
+    soma_latencia_despertar_us += latencia;
+    despertares_por_liberacao++;
+    pthread_mutex_unlock(&mutex_stats);
+}
+
+// função para esperar a liberação de recursos até o prazo (chamar com mutex_recursos travado)
+// com req, espera só pela própria requisição; sem req (reserva do planejador), pela palavra global
+void aguardar_recursos(requisicao_t* req, long long prazo_ms) {
+    long long inicio_us = get_time_us();
+
+#if SINCRONIZACAO_FUTEX
+    if (sincronizacao_futex) {
+        atomic_uint* palavra = (req != NULL) ? &req->despertar : &geracao_recursos;
+        atomic_int* esperando = (req != NULL) ? &req->estacionada : &esperando_recursos;
+        unsigned int geracao = atomic_load(palavra);
+        pthread_mutex_unlock(&mutex_recursos);
+
+        // seções críticas curtas: girar um pouco antes de estacionar
+        int notificado = 0;
+        for (int i = 0; i < SPIN_ITERACOES; i++) {
+            if (atomic_load_explicit(palavra, memory_order_acquire) != geracao) {
+                notificado = 1;
+                break;
+            }
+            PAUSA_CPU();
+        }
+
+        long long restante_ms = prazo_ms - get_time_ms();
+        if (!notificado && restante_ms > 0) {
+            struct timespec timeout;
+            timeout.tv_sec = restante_ms / 1000;
+            timeout.tv_nsec = (restante_ms % 1000) * 1000000;
+
+            // retorna na hora se a palavra já mudou (sem perda de notificação)
+            atomic_fetch_add(esperando, 1);
+            syscall(SYS_futex, palavra, FUTEX_WAIT_PRIVATE, geracao, &timeout, NULL, 0);
+            atomic_fetch_sub(esperando, 1);
+            notificado = atomic_load(palavra) != geracao;
+        }
+
+        pthread_mutex_lock(&mutex_recursos);
+        if (notificado) {
+            registrar_latencia_despertar(inicio_us);
+        }
+        return;
+    }
+#endif
+
+    // linha de base pthread: todos esperam em cond_recursos e cada notificação acorda todos
+    (void)req;
+    struct timespec timeout = ms_para_timespec(prazo_ms);
+    if (pthread_cond_timedwait(&cond_recursos, &mutex_recursos, &timeout) == 0) {
+        registrar_latencia_despertar(inicio_us);
+    }
+}
+
+// função para acordar só a primeira requisição da fila, a única que pode alocar
+// (chamar com mutex_recursos travado: a requisição só sai da fila sob ele)
+// o incremento da palavra e a leitura de 'estacionada' são seq_cst, assim como o lado de quem
+// espera: com ordem mais fraca o FUTEX_WAKE poderia ser pulado e a thread dormiria até o prazo
+void acordar_primeira_requisicao() {
+#if SINCRONIZACAO_FUTEX
+    if (sincronizacao_futex) {
+        if (num_requisicoes == 0) return;
+
+        requisicao_t* primeira = fila_requisicoes[0];
+        atomic_fetch_add(&primeira->despertar, 1);
+        if (atomic_load(&primeira->estacionada) > 0) {
+            syscall(SYS_futex, &primeira->despertar, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+        }
+        return;
+    }
+#endif
+
+    pthread_cond_broadcast(&cond_recursos);
+}
+
+// função para acordar quem espera por recursos liberados (chamar com mutex_recursos travado)
+void notificar_recursos() {
+    // aviões do planejador esperam recursos específicos da reserva: todos verificam
+#if SINCRONIZACAO_FUTEX
+    if (sincronizacao_futex) {
+        acordar_primeira_requisicao();
+
+        atomic_fetch_add(&geracao_recursos, 1);
+        if (atomic_load(&esperando_recursos) > 0) {
+            syscall(SYS_futex, &geracao_recursos, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+        }
+        return;
+    }
+#endif
+
+    pthread_cond_broadcast(&cond_recursos);
+}
+
 // função para verificar disponibilidade de recursos
 int verificar_recursos_disponiveis(int precisa_pista, int precisa_portao, int precisa_torre,
                                    int* pista_disponivel, int* portao_disponivel) {
@@ -231,7 +643,7 @@ int verificar_recursos_disponiveis(int precisa_pista, int precisa_portao, int pr
         for (int i = 0; i < NUM_PISTAS; i++) {
             int val;
             sem_getvalue(&pistas[i], &val);
-            if (val > 0) {
+            if (val > 0 && !atomic_load(&pista_fechada[i])) {
                 *pista_disponivel = i;
                 break;
             }
@@ -244,7 +656,7 @@ int verificar_recursos_disponiveis(int precisa_pista, int precisa_portao, int pr
         for (int i = 0; i < NUM_PORTOES; i++) {
             int val;
             sem_getvalue(&portoes[i], &val);
-            if (val > 0) {
+            if (val > 0 && !atomic_load(&portao_fechado[i])) {
                 *portao_disponivel = i;
                 break;
             }
@@ -252,13 +664,23 @@ int verificar_recursos_disponiveis(int precisa_pista, int precisa_portao, int pr
         if (*portao_disponivel == -1) recursos_ok = 0;
     }
 
-    if (precisa_torre && torre_livre <= 0) {
+    if (precisa_torre && atomic_load(&torre_livre) <= 0) {
         recursos_ok = 0;
     }
 
     return recursos_ok;
 }
 
+// função para encerrar a liberação do circuito quando o avião já disputa a pista de pouso
+void concluir_liberacao_circuito(aviao_t *aviao) {
+    if (!aviao->liberado_circuito) return;
+
+    pthread_mutex_lock(&mutex_admissao);
+    liberacoes_pendentes--;
+    aviao->liberado_circuito = 0;
+    pthread_mutex_unlock(&mutex_admissao);
+}
+
 // função para alocar todos os recursos de uma vez (evita deadlock)
 int alocar_recursos_atomicos(aviao_t *aviao, int precisa_pista, int precisa_portao,
                             int precisa_torre, int* pista_alocada, int* portao_alocado) {
@@ -267,8 +689,16 @@ int alocar_recursos_atomicos(aviao_t *aviao, int precisa_pista, int precisa_port
     req.aviao_id = aviao->id;
     req.prioridade = aviao->prioridade;
     req.tentativas = aviao->tentativas_totais;
-    gettimeofday(&req.timestamp, NULL);
+    if (aviao->requisicao_restaurada) {
+        // mantém a posição que a requisição tinha na fila no checkpoint
+        req.timestamp = aviao->timestamp_requisicao;
+        aviao->requisicao_restaurada = 0;
+    } else {
+        gettimeofday(&req.timestamp, NULL);
+    }
     pthread_cond_init(&req.cond, NULL);
+    atomic_init(&req.despertar, 0);
+    atomic_init(&req.estacionada, 0);
     req.recursos_alocados = 0;
     req.pista_alocada = -1;
     req.portao_alocado = -1;
@@ -276,6 +706,9 @@ int alocar_recursos_atomicos(aviao_t *aviao, int precisa_pista, int precisa_port
 
     inserir_requisicao(&req);
 
+    // já visível na fila para a admissão: o circuito pode liberar o próximo
+    concluir_liberacao_circuito(aviao);
+
     pthread_mutex_lock(&mutex_recursos);
 
     int tentativas_locais = 0;
@@ -303,9 +736,7 @@ int alocar_recursos_atomicos(aviao_t *aviao, int precisa_pista, int precisa_port
                 }
 
                 if (sucesso && precisa_torre) {
-                    if (torre_livre > 0) {
-                        torre_livre--;
-                    } else {
+                    if (!torre_tentar_adquirir()) {
                         if (precisa_pista) sem_post(&pistas[pista_disp]);
                         if (precisa_portao) sem_post(&portoes[portao_disp]);
                         sucesso = 0;
@@ -336,8 +767,11 @@ int alocar_recursos_atomicos(aviao_t *aviao, int precisa_pista, int precisa_port
             req.prioridade = aviao->prioridade;
             req.tentativas = aviao->tentativas_totais;
 
-            // reordenar fila com nova prioridade
+            // reordenar fila com nova prioridade (com despertar seletivo, quem passou à frente é acordado)
             qsort(fila_requisicoes, num_requisicoes, sizeof(requisicao_t*), comparar_prioridade);
+            if (sincronizacao_futex && fila_requisicoes[0] != &req) {
+                acordar_primeira_requisicao();
+            }
 
             safe_print("🔄 Avião %d FALHOU em obter recursos (tentativa %d/%d). Nova prioridade: %d\n",
                       aviao->id, tentativas_locais, MAX_TENTATIVAS, aviao->prioridade);
@@ -348,18 +782,17 @@ int alocar_recursos_atomicos(aviao_t *aviao, int precisa_pista, int precisa_port
             }
 
             // esperar um pouco antes de tentar novamente
-            struct timespec timeout;
-            clock_gettime(CLOCK_REALTIME, &timeout);
-            timeout.tv_sec += 2;
-
-            pthread_cond_timedwait(&cond_recursos, &mutex_recursos, &timeout);
+            aguardar_recursos(&req, get_time_ms() + TEMPO_ESPERA_RECURSOS_MS);
         }
     }
 
     pthread_mutex_unlock(&mutex_recursos);
 
-    // remover da fila
+    // remover da fila e acordar a nova primeira requisição
     remover_requisicao(aviao->id);
+    pthread_mutex_lock(&mutex_recursos);
+    acordar_primeira_requisicao();
+    pthread_mutex_unlock(&mutex_recursos);
     pthread_cond_destroy(&req.cond);
 
     // verificar se desistiu após muitas tentativas
@@ -374,9 +807,6 @@ int alocar_recursos_atomicos(aviao_t *aviao, int precisa_pista, int precisa_port
         return 0;
     }
 
-    // notificar outras threads que recursos podem estar disponíveis
-    pthread_cond_broadcast(&cond_recursos);
-
     return req.recursos_alocados;
 }
 
@@ -393,45 +823,603 @@ void liberar_recursos_atomicos(int pista, int portao, int torre) {
     }
 
     if (torre) {
-        torre_livre++;
+        torre_liberar();
     }
 
     // acordar threads esperando por recursos
-    pthread_cond_broadcast(&cond_recursos);
+    atomic_store(&ultima_liberacao_us, get_time_us());
+    notificar_recursos();
 
     pthread_mutex_unlock(&mutex_recursos);
 }
 
-// função para operação de pouso
-int realizar_pouso(aviao_t *aviao) {
-    safe_print("🛬 Avião %d (%s) iniciando procedimento de POUSO!\n",
+// função para calcular a ocupação dos recursos em porcentagem (chamar com mutex_recursos travado)
+// recursos fechados contam como ocupados, para a admissão enxergar a capacidade reduzida
+int calcular_ocupacao_recursos() {
+    int ocupados = 0;
+
+    for (int i = 0; i < NUM_PISTAS; i++) {
+        int val;
+        sem_getvalue(&pistas[i], &val);
+        if (val <= 0 || atomic_load(&pista_fechada[i])) ocupados++;
+    }
+
+    for (int i = 0; i < NUM_PORTOES; i++) {
+        int val;
+        sem_getvalue(&portoes[i], &val);
+        if (val <= 0 || atomic_load(&portao_fechado[i])) ocupados++;
+    }
+
+    int capacidade = atomic_load(&capacidade_torre);
+    int torre_ocupada = capacidade - atomic_load(&torre_livre);
+    ocupados += (torre_ocupada > 0) ? torre_ocupada : 0;
+
+    int total = NUM_PISTAS + NUM_PORTOES + capacidade;
+    if (ocupados >= total) return 100;
+    return ocupados * 100 / total;
+}
+
+// função para verificar congestionamento pela fila e pela ocupação dos recursos
+int aeroporto_congestionado() {
+    pthread_mutex_lock(&mutex_recursos);
+
+    int congestionado = num_requisicoes >= LIMITE_FILA_ADMISSAO ||
+                        calcular_ocupacao_recursos() >= LIMITE_OCUPACAO_ADMISSAO;
+
+    pthread_mutex_unlock(&mutex_recursos);
+
+    return congestionado;
+}
+
+// função para desviar o avião para um aeroporto alternativo
+void desviar_aviao(aviao_t *aviao, const char* motivo) {
+    transicao_aviao(aviao, DESVIADO, -1, -1);
+
+    pthread_mutex_lock(&mutex_stats);
+    avioes_desviados++;
+    pthread_mutex_unlock(&mutex_stats);
+
+    safe_print("↪️ Avião %d (%s) DESVIADO para aeroporto alternativo: %s\n",
+              aviao->id, (aviao->tipo == INTERNACIONAL) ? "INT" : "DOM", motivo);
+}
+
+// função para o avião orbitar no circuito de espera até ser admitido ou desviado
+int orbitar_circuito(aviao_t *aviao) {
+    // ao fim da simulação o circuito é esvaziado para os aviões não sobreviverem à limpeza final
+    int admitido = 0;
+    while (simulacao_ativa && aviao->voltas_circuito < MAX_VOLTAS_CIRCUITO) {
+        sleep(TEMPO_VOLTA_CIRCUITO);
+        aviao->voltas_circuito++;
+
+        // verificação e liberação atômicas: um avião por vez, e o próximo só depois que o
+        // liberado aparecer na fila ou na pista (senão vários veriam o aeroporto livre juntos)
+        pthread_mutex_lock(&mutex_admissao);
+        if (liberacoes_pendentes == 0 && !aeroporto_congestionado()) {
+            liberacoes_pendentes++;
+            avioes_em_circuito--;
+            aviao->liberado_circuito = 1;
+            admitido = 1;
+        }
+        pthread_mutex_unlock(&mutex_admissao);
+
+        if (admitido) break;
+    }
+
+    if (!admitido) {
+        pthread_mutex_lock(&mutex_admissao);
+        avioes_em_circuito--;
+        pthread_mutex_unlock(&mutex_admissao);
+
+        desviar_aviao(aviao, simulacao_ativa ? "limite de voltas no circuito atingido"
+                                             : "simulação encerrada");
+        return 0;
+    }
+
+    transicao_aviao(aviao, AGUARDANDO_POUSO, -1, -1);
+    safe_print("🛬 Avião %d deixou o circuito de espera após %d volta(s)\n",
+              aviao->id, aviao->voltas_circuito);
+
+    return 1;
+}
+
+// função de controle de admissão: decide se o avião inicia o pouso, entra no circuito ou é desviado
+int admitir_aviao(aviao_t *aviao) {
+    pthread_mutex_lock(&mutex_admissao);
+
+    // aviões no circuito têm preferência sobre novas chegadas, inclusive o recém-liberado
+    // que ainda não apareceu na fila
+    if (avioes_em_circuito == 0 && liberacoes_pendentes == 0 && !aeroporto_congestionado()) {
+        pthread_mutex_unlock(&mutex_admissao);
+        return 1;
+    }
+
+    // backpressure: circuito lotado, a chegada é desviada
+    if (avioes_em_circuito >= MAX_CIRCUITO_ESPERA) {
+        pthread_mutex_unlock(&mutex_admissao);
+        desviar_aviao(aviao, "circuito de espera lotado");
+        return 0;
+    }
+
+    avioes_em_circuito++;
+    pthread_mutex_unlock(&mutex_admissao);
+
+    pthread_mutex_lock(&mutex_stats);
+    avioes_circuito_total++;
+    pthread_mutex_unlock(&mutex_stats);
+
+    aviao->passou_circuito = 1;
+    transicao_aviao(aviao, EM_CIRCUITO, -1, -1);
+    safe_print("🌀 Avião %d (%s) entrou no CIRCUITO DE ESPERA (aeroporto congestionado)\n",
               aviao->id, (aviao->tipo == INTERNACIONAL) ? "INT" : "DOM");
 
-    aviao->estado = AGUARDANDO_POUSO;
-    resetar_cronometro(aviao);
+    return orbitar_circuito(aviao);
+}
+
+// função para acumular tempo de ocupação de um recurso nas estatísticas
+void registrar_ocupacao(long long* acumulador, long long inicio_ms) {
+    pthread_mutex_lock(&mutex_stats);
+    *acumulador += get_time_ms() - inicio_ms;
+    pthread_mutex_unlock(&mutex_stats);
+}
+
+// função para registrar uma operação concluída no histórico de vazão por segundo
+void registrar_operacao_concluida() {
+    long long segundo = (get_time_ms() - inicio_execucao_ms) / 1000;
+    if (segundo < 0 || segundo >= MAX_SEGUNDOS_VAZAO) return;
 
-    int pista_alocada = -1, portao_alocado = -1;
+    pthread_mutex_lock(&mutex_stats);
+    operacoes_por_segundo[segundo]++;
+    pthread_mutex_unlock(&mutex_stats);
+}
 
-    // alocar recursos necessários para pouso (pista + torre)
-    if (!alocar_recursos_atomicos(aviao, 1, 0, 1, &pista_alocada, &portao_alocado)) {
-        return 0; // falhou ou arremeteu
+// função para descartar reservas já encerradas (chamar com mutex_planejador travado)
+void descartar_reservas_expiradas(long long agora) {
+    int j = 0;
+    for (int i = 0; i < num_reservas; i++) {
+        if (reservas[i].fim_ms > agora) {
+            reservas[j++] = reservas[i];
+        }
     }
+    num_reservas = j;
+}
+
+// função para remover as reservas de um avião a partir de uma fase (chamar com mutex_planejador travado)
+void remover_reservas_aviao(int aviao_id, fase_t fase_inicial) {
+    int j = 0;
+    for (int i = 0; i < num_reservas; i++) {
+        if (reservas[i].aviao_id != aviao_id || reservas[i].fase < fase_inicial) {
+            reservas[j++] = reservas[i];
+        }
+    }
+    num_reservas = j;
+}
 
-    if (aviao->estado == CAIU || aviao->estado == ARREMETEU) {
+// função para verificar se um recurso está livre em uma janela (chamar com mutex_planejador travado)
+int recurso_livre(tipo_recurso_t recurso, int indice, long long inicio, long long fim) {
+    if ((recurso == RECURSO_PISTA && atomic_load(&pista_fechada[indice])) ||
+        (recurso == RECURSO_PORTAO && atomic_load(&portao_fechado[indice]))) {
         return 0;
     }
 
-    aviao->pista_alocada = pista_alocada;
+    for (int i = 0; i < num_reservas; i++) {
+        reserva_t* r = &reservas[i];
+        if (r->recurso == recurso && r->indice == indice &&
+            r->inicio_ms < fim && inicio < r->fim_ms) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// função para procurar um recurso livre em uma janela; retorna o índice ou -1
+int procurar_recurso_livre(tipo_recurso_t recurso, long long inicio, long long fim) {
+    int quantidade = (recurso == RECURSO_PISTA) ? NUM_PISTAS :
+                     (recurso == RECURSO_PORTAO) ? NUM_PORTOES : atomic_load(&capacidade_torre);
+
+    for (int i = 0; i < quantidade; i++) {
+        if (recurso_livre(recurso, i, inicio, fim)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// função para verificar se a reserva de portão de um avião pode ser estendida até 'fim' sem sobrepor
+// a de outro avião (o avião já está no portão, então um fechamento não impede; chamar com mutex_planejador travado)
+int portao_extensivel(int aviao_id, int portao, long long fim) {
+    long long fim_atual = get_time_ms();
+    for (int i = 0; i < num_reservas; i++) {
+        reserva_t* r = &reservas[i];
+        if (r->aviao_id == aviao_id && r->recurso == RECURSO_PORTAO && r->fim_ms > fim_atual) {
+            fim_atual = r->fim_ms;
+        }
+    }
+
+    for (int i = 0; i < num_reservas; i++) {
+        reserva_t* r = &reservas[i];
+        if (r->aviao_id != aviao_id && r->recurso == RECURSO_PORTAO && r->indice == portao &&
+            r->inicio_ms < fim && fim_atual < r->fim_ms) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// função para registrar uma reserva (chamar com mutex_planejador travado)
+void adicionar_reserva(int aviao_id, fase_t fase, tipo_recurso_t recurso, int indice,
+                       long long inicio, long long fim) {
+    reserva_t* r = &reservas[num_reservas++];
+    r->aviao_id = aviao_id;
+    r->fase = fase;
+    r->recurso = recurso;
+    r->indice = indice;
+    r->inicio_ms = inicio;
+    r->fim_ms = fim;
+}
+
+// função para tentar montar o plano com a primeira fase começando exatamente em 'inicio'
+// (fases seguintes podem esperar até FOLGA_ENTRE_FASES_MS; chamar com mutex_planejador travado)
+int tentar_plano(aviao_t *aviao, fase_t fase, long long inicio) {
+    plano_voo_t *plano = &aviao->plano;
+
+    // pouso: pista + torre
+    int pista_pouso = -1, torre_pouso = -1;
+    long long fim_pouso = inicio;
+    if (fase == FASE_POUSO) {
+        fim_pouso = inicio + TEMPO_POUSO * 1000LL;
+        pista_pouso = procurar_recurso_livre(RECURSO_PISTA, inicio, fim_pouso);
+        torre_pouso = procurar_recurso_livre(RECURSO_TORRE, inicio, fim_pouso);
+        if (pista_pouso < 0 || torre_pouso < 0) return 0;
+    }
+
+    // desembarque: portão (mantido até a decolagem) + torre
+    long long folga_desembarque = (fase == FASE_POUSO) ? FOLGA_ENTRE_FASES_MS : 0;
+    for (long long t2 = fim_pouso; t2 <= fim_pouso + folga_desembarque; t2 += SLOT_PLANEJAMENTO_MS) {
+        int torre_desembarque = -1;
+        long long fim_desembarque = t2;
+        if (fase <= FASE_DESEMBARQUE) {
+            fim_desembarque = t2 + TEMPO_DESEMBARQUE * 1000LL;
+            torre_desembarque = procurar_recurso_livre(RECURSO_TORRE, t2, fim_desembarque);
+            if (torre_desembarque < 0) continue;
+        }
+
+        // decolagem: pista + torre
+        long long folga_decolagem = (fase == FASE_DECOLAGEM) ? 0 : FOLGA_ENTRE_FASES_MS;
+        for (long long t3 = fim_desembarque; t3 <= fim_desembarque + folga_decolagem;
+             t3 += SLOT_PLANEJAMENTO_MS) {
+            long long fim_decolagem = t3 + TEMPO_DECOLAGEM * 1000LL;
+            int pista_decolagem = procurar_recurso_livre(RECURSO_PISTA, t3, fim_decolagem);
+            int torre_decolagem = procurar_recurso_livre(RECURSO_TORRE, t3, fim_decolagem);
+            if (pista_decolagem < 0 || torre_decolagem < 0) continue;
+
+            // na decolagem o portão já está ocupado desde o desembarque: a reserva só pode
+            // ser estendida se ninguém o reservou depois do fim atual
+            int portao = plano->portao;
+            if (fase <= FASE_DESEMBARQUE) {
+                portao = procurar_recurso_livre(RECURSO_PORTAO, t2, fim_decolagem);
+                if (portao < 0) continue;
+            } else if (!portao_extensivel(aviao->id, portao, fim_decolagem)) {
+                continue;
+            }
+
+            if (num_reservas + 2 * NUM_FASES > MAX_RESERVAS) return 0;
+
+            // confirmar as reservas
+            if (fase == FASE_POUSO) {
+                adicionar_reserva(aviao->id, FASE_POUSO, RECURSO_PISTA, pista_pouso, inicio, fim_pouso);
+                adicionar_reserva(aviao->id, FASE_POUSO, RECURSO_TORRE, torre_pouso, inicio, fim_pouso);
+                plano->inicio_ms[FASE_POUSO] = inicio;
+                plano->pista[FASE_POUSO] = pista_pouso;
+            }
+
+            if (fase <= FASE_DESEMBARQUE) {
+                adicionar_reserva(aviao->id, FASE_DESEMBARQUE, RECURSO_TORRE, torre_desembarque,
+                                  t2, fim_desembarque);
+                adicionar_reserva(aviao->id, FASE_DESEMBARQUE, RECURSO_PORTAO, portao, t2, fim_decolagem);
+                plano->inicio_ms[FASE_DESEMBARQUE] = t2;
+                plano->portao = portao;
+            } else {
+                // estender a reserva do portão até a nova decolagem (recriá-la se já expirou)
+                int estendida = 0;
+                for (int i = 0; i < num_reservas; i++) {
+                    if (reservas[i].aviao_id == aviao->id && reservas[i].recurso == RECURSO_PORTAO) {
+                        reservas[i].fim_ms = fim_decolagem;
+                        estendida = 1;
+                    }
+                }
+                if (!estendida) {
+                    adicionar_reserva(aviao->id, FASE_DESEMBARQUE, RECURSO_PORTAO, portao,
+                                      get_time_ms(), fim_decolagem);
+                }
+            }
+
+            adicionar_reserva(aviao->id, FASE_DECOLAGEM, RECURSO_PISTA, pista_decolagem, t3, fim_decolagem);
+            adicionar_reserva(aviao->id, FASE_DECOLAGEM, RECURSO_TORRE, torre_decolagem, t3, fim_decolagem);
+            plano->inicio_ms[FASE_DECOLAGEM] = t3;
+            plano->pista[FASE_DECOLAGEM] = pista_decolagem;
+            plano->pista[FASE_DESEMBARQUE] = -1;
+            plano->valido = 1;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// função para planejar as fases restantes de um avião a partir de 'fase' (chamar com mutex_planejador travado)
+int planejar_fases(aviao_t *aviao, fase_t fase, long long inicio_busca) {
+    descartar_reservas_expiradas(get_time_ms());
+    remover_reservas_aviao(aviao->id, fase);
+    aviao->plano.valido = 0;
+
+    long long limite = inicio_busca + HORIZONTE_PLANEJAMENTO * 1000LL;
+    for (long long inicio = inicio_busca; inicio <= limite; inicio += SLOT_PLANEJAMENTO_MS) {
+        if (tentar_plano(aviao, fase, inicio)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// função para reservar, na chegada, os slots de pouso, desembarque e decolagem
+void planejar_voo(aviao_t *aviao) {
+    long long agora = get_time_ms();
+
+    pthread_mutex_lock(&mutex_planejador);
+    int planejado = planejar_fases(aviao, FASE_POUSO, agora);
+    pthread_mutex_unlock(&mutex_planejador);
+
+    if (!planejado) {
+        pthread_mutex_lock(&mutex_stats);
+        voos_sem_plano++;
+        pthread_mutex_unlock(&mutex_stats);
+
+        safe_print("🗓️ Avião %d sem slots no horizonte de %d segundos, usando alocação por contenção\n",
+                  aviao->id, HORIZONTE_PLANEJAMENTO);
+        return;
+    }
+
+    plano_voo_t *plano = &aviao->plano;
+    safe_print("🗓️ Avião %d PLANEJADO: pouso em +%.2fs (pista %d), desembarque em +%.2fs (portão %d), decolagem em +%.2fs (pista %d)\n",
+              aviao->id,
+              (plano->inicio_ms[FASE_POUSO] - agora) / 1000.0, plano->pista[FASE_POUSO],
+              (plano->inicio_ms[FASE_DESEMBARQUE] - agora) / 1000.0, plano->portao,
+              (plano->inicio_ms[FASE_DECOLAGEM] - agora) / 1000.0, plano->pista[FASE_DECOLAGEM]);
+}
+
+// função para reservar um recurso já ocupado por um avião retomado (chamar com mutex_planejador travado)
+void reservar_ocupacao_retomada(aviao_t *aviao, fase_t fase, tipo_recurso_t recurso, int indice,
+                                long long inicio, long long fim) {
+    if (recurso == RECURSO_TORRE) {
+        indice = procurar_recurso_livre(RECURSO_TORRE, inicio, fim);
+    }
+    if (indice >= 0 && num_reservas < MAX_RESERVAS) {
+        adicionar_reserva(aviao->id, fase, recurso, indice, inicio, fim);
+    }
+}
+
+// função para replanejar um avião restaurado de um checkpoint a partir do seu estado
+void planejar_voo_retomado(aviao_t *aviao) {
+    if (aviao->estado == AGUARDANDO_POUSO) {
+        planejar_voo(aviao);
+        return;
+    }
+
+    long long agora = get_time_ms();
+    long long horizonte = agora + HORIZONTE_PLANEJAMENTO * 1000LL;
+    fase_t proxima_fase = NUM_FASES;
+    long long inicio_busca = agora;
+
+    pthread_mutex_lock(&mutex_planejador);
+    descartar_reservas_expiradas(agora);
+    remover_reservas_aviao(aviao->id, FASE_POUSO);
+    aviao->plano.valido = 0;
+
+    // recursos já ocupados ficam reservados até o fim da operação em andamento
+    switch (aviao->estado) {
+        case POUSANDO:
+            inicio_busca = aviao->inicio_operacao_ms + TEMPO_POUSO * 1000LL;
+            reservar_ocupacao_retomada(aviao, FASE_POUSO, RECURSO_PISTA, aviao->pista_alocada, agora, inicio_busca);
+            reservar_ocupacao_retomada(aviao, FASE_POUSO, RECURSO_TORRE, -1, agora, inicio_busca);
+            proxima_fase = FASE_DESEMBARQUE;
+            break;
+        case AGUARDANDO_DESEMBARQUE:
+            proxima_fase = FASE_DESEMBARQUE;
+            break;
+        case DESEMBARCANDO:
+            inicio_busca = aviao->inicio_operacao_ms + TEMPO_DESEMBARQUE * 1000LL;
+            reservar_ocupacao_retomada(aviao, FASE_DESEMBARQUE, RECURSO_TORRE, -1, agora, inicio_busca);
+            reservar_ocupacao_retomada(aviao, FASE_DESEMBARQUE, RECURSO_PORTAO, aviao->portao_alocado, agora, horizonte);
+            proxima_fase = FASE_DECOLAGEM;
+            break;
+        case AGUARDANDO_DECOLAGEM:
+            reservar_ocupacao_retomada(aviao, FASE_DESEMBARQUE, RECURSO_PORTAO, aviao->portao_alocado, agora, horizonte);
+            proxima_fase = FASE_DECOLAGEM;
+            break;
+        case DECOLANDO: {
+            long long fim = aviao->inicio_operacao_ms + TEMPO_DECOLAGEM * 1000LL;
+            reservar_ocupacao_retomada(aviao, FASE_DECOLAGEM, RECURSO_PISTA, aviao->pista_alocada, agora, fim);
+            reservar_ocupacao_retomada(aviao, FASE_DECOLAGEM, RECURSO_TORRE, -1, agora, fim);
+            reservar_ocupacao_retomada(aviao, FASE_DESEMBARQUE, RECURSO_PORTAO, aviao->portao_alocado, agora, fim);
+            break;
+        }
+        default:
+            break;
+    }
+
+    int planejado = 1;
+    if (proxima_fase != NUM_FASES) {
+        aviao->plano.portao = aviao->portao_alocado;
+        planejado = planejar_fases(aviao, proxima_fase, (inicio_busca > agora) ? inicio_busca : agora);
+    }
+    pthread_mutex_unlock(&mutex_planejador);
+
+    if (!planejado) {
+        pthread_mutex_lock(&mutex_stats);
+        voos_sem_plano++;
+        pthread_mutex_unlock(&mutex_stats);
+
+        safe_print("🗓️ Avião %d retomado sem slots no horizonte, usando alocação por contenção\n", aviao->id);
+    }
+}
+
+// função para cancelar as reservas restantes de um avião
+void cancelar_plano(aviao_t *aviao) {
+    pthread_mutex_lock(&mutex_planejador);
+    remover_reservas_aviao(aviao->id, FASE_POUSO);
+    aviao->plano.valido = 0;
+    pthread_mutex_unlock(&mutex_planejador);
+}
+
+// função para executar uma fase contra a reserva do plano
+// retorna 0 se o avião deve voltar à alocação por contenção (ou caiu)
+int executar_reserva(aviao_t *aviao, fase_t fase, int precisa_portao,
+                     int* pista_alocada, int* portao_alocado) {
+    while (1) {
+        // aguardar o início do slot reservado (main acorda todos ao encerrar a simulação)
+        pthread_mutex_lock(&mutex_planejador);
+        while (simulacao_ativa && aviao->plano.valido && get_time_ms() < aviao->plano.inicio_ms[fase]) {
+            struct timespec prazo = ms_para_timespec(aviao->plano.inicio_ms[fase]);
+            pthread_cond_timedwait(&cond_planejador, &mutex_planejador, &prazo);
+        }
+
+        if (!aviao->plano.valido) {
+            pthread_mutex_unlock(&mutex_planejador);
+            return 0;
+        }
+
+        // fim da simulação: slots podem estar até HORIZONTE_PLANEJAMENTO à frente e a thread não
+        // sobreviveria à limpeza final; quem ainda não pousou é desviado, quem está em solo segue por contenção
+        if (!simulacao_ativa && get_time_ms() < aviao->plano.inicio_ms[fase]) {
+            pthread_mutex_unlock(&mutex_planejador);
+            if (fase == FASE_POUSO) {
+                desviar_aviao(aviao, "simulação encerrada");
+            }
+            return 0;
+        }
+
+        int pista = aviao->plano.pista[fase];
+        int portao = precisa_portao ? aviao->plano.portao : -1;
+        long long prazo_ms = aviao->plano.inicio_ms[fase] + TOLERANCIA_ATRASO_MS;
+        pthread_mutex_unlock(&mutex_planejador);
+
+        // ocupar os recursos reservados (atrasos de outros aviões podem mantê-los ocupados)
+        pthread_mutex_lock(&mutex_recursos);
+
+        int alocado = 0;
+        while (!alocado) {
+            // recurso reservado fechado por um evento: replanejar sem esperar a tolerância
+            if ((pista >= 0 && atomic_load(&pista_fechada[pista])) ||
+                (portao >= 0 && atomic_load(&portao_fechado[portao]))) {
+                break;
+            }
+
+            if (torre_tentar_adquirir()) {
+                if (pista < 0 || sem_trywait(&pistas[pista]) == 0) {
+                    if (portao < 0 || sem_trywait(&portoes[portao]) == 0) {
+                        alocado = 1;
+                        break;
+                    }
+                    if (pista >= 0) sem_post(&pistas[pista]);
+                }
+                torre_liberar();
+            }
+
+            if (get_time_ms() >= prazo_ms) break;
+
+            aguardar_recursos(NULL, prazo_ms);
+        }
+
+        pthread_mutex_unlock(&mutex_recursos);
+
+        if (alocado) {
+            *pista_alocada = pista;
+            *portao_alocado = portao;
+
+            safe_print("🔒 Avião %d OCUPOU recursos reservados: Pista=%d, Portão=%d, Torre=1\n",
+                      aviao->id, pista, portao);
+            return 1;
+        }
+
+        // recursos reservados ainda ocupados: replanejar as fases restantes
+        pthread_mutex_lock(&mutex_planejador);
+        int replanejado = planejar_fases(aviao, fase, get_time_ms());
+        pthread_mutex_unlock(&mutex_planejador);
+
+        pthread_mutex_lock(&mutex_stats);
+        replanejamentos++;
+        pthread_mutex_unlock(&mutex_stats);
+
+        if (!replanejado) {
+            safe_print("🗓️ Avião %d não conseguiu replanejar, usando alocação por contenção\n", aviao->id);
+            return 0;
+        }
+
+        safe_print("🗓️ Avião %d REPLANEJADO por atraso: fase %d em +%.2fs\n",
+                  aviao->id, fase, (aviao->plano.inicio_ms[fase] - get_time_ms()) / 1000.0);
+
+        if (!verificar_estado_critico(aviao)) {
+            return 0; // caiu
+        }
+    }
+}
+
+// função para alocar os recursos de uma fase, pela reserva do plano ou por contenção
+int alocar_recursos_fase(aviao_t *aviao, fase_t fase, int precisa_pista, int precisa_portao,
+                         int* pista_alocada, int* portao_alocado) {
+    if (planejador_ativo && aviao->plano.valido) {
+        if (executar_reserva(aviao, fase, precisa_portao, pista_alocada, portao_alocado)) {
+            return 1;
+        }
+        if (estado_terminal(aviao->estado)) {
+            return 0;
+        }
+    }
+
+    return alocar_recursos_atomicos(aviao, precisa_pista, precisa_portao, 1,
+                                    pista_alocada, portao_alocado);
+}
+
+// função para operação de pouso
+int realizar_pouso(aviao_t *aviao) {
+    int pista_alocada = aviao->pista_alocada, portao_alocado = -1;
+
+    // avião restaurado no meio do pouso já ocupa pista e torre
+    if (aviao->estado != POUSANDO) {
+        safe_print("🛬 Avião %d (%s) iniciando procedimento de POUSO!\n",
+                  aviao->id, (aviao->tipo == INTERNACIONAL) ? "INT" : "DOM");
+
+        if (aviao->retomado) {
+            aviao->retomado = 0; // mantém o cronômetro de espera do checkpoint
+        } else {
+            aviao->estado = AGUARDANDO_POUSO;
+            resetar_cronometro(aviao);
+        }
+
+        // alocar recursos necessários para pouso (pista + torre)
+        int alocou = alocar_recursos_fase(aviao, FASE_POUSO, 1, 0, &pista_alocada, &portao_alocado);
+        concluir_liberacao_circuito(aviao);
+        if (!alocou) {
+            return 0; // falhou ou arremeteu
+        }
+
+        if (aviao->estado == CAIU || aviao->estado == ARREMETEU) {
+            return 0;
+        }
 
-    // realizar pouso
-    aviao->estado = POUSANDO;
-    safe_print("🛬 Avião %d POUSANDO na pista %d!\n", aviao->id, pista_alocada);
+        // realizar pouso
+        transicao_aviao(aviao, POUSANDO, pista_alocada, -1);
+        safe_print("🛬 Avião %d POUSANDO na pista %d!\n", aviao->id, pista_alocada);
+    }
 
-    sleep(2); // tempo de pouso
+    aguardar_operacao(aviao, TEMPO_POUSO); // tempo de pouso
 
     // liberar recursos do pouso
+    registrar_ocupacao(&tempo_pistas_ocupadas_ms, aviao->inicio_operacao_ms);
+    concluir_operacao(aviao, AGUARDANDO_DESEMBARQUE, -1, -1);
     liberar_recursos_atomicos(pista_alocada, -1, 1);
-    aviao->pista_alocada = -1;
 
     safe_print("✅  Avião %d POUSOU com sucesso! Pista %d e torre liberadas!\n",
               aviao->id, pista_alocada);
@@ -441,31 +1429,39 @@ int realizar_pouso(aviao_t *aviao) {
 
 // função para operação de desembarque
 int realizar_desembarque(aviao_t *aviao) {
-    safe_print("💺 Avião %d iniciando procedimento de DESEMBARQUE!\n", aviao->id);
+    int pista_alocada = -1, portao_alocado = aviao->portao_alocado;
 
-    aviao->estado = AGUARDANDO_DESEMBARQUE;
-    resetar_cronometro(aviao);
+    // avião restaurado no meio do desembarque já ocupa portão e torre
+    if (aviao->estado != DESEMBARCANDO) {
+        safe_print("💺 Avião %d iniciando procedimento de DESEMBARQUE!\n", aviao->id);
 
-    int pista_alocada = -1, portao_alocado = -1;
+        if (aviao->retomado) {
+            aviao->retomado = 0; // mantém o cronômetro de espera do checkpoint
+        } else {
+            aviao->estado = AGUARDANDO_DESEMBARQUE;
+            resetar_cronometro(aviao);
+        }
 
-    // alocar recursos necessários para desembarque (portão + torre)
-    if (!alocar_recursos_atomicos(aviao, 0, 1, 1, &pista_alocada, &portao_alocado)) {
-        return 0; // falhou ou arremeteu
-    }
+        // alocar recursos necessários para desembarque (portão + torre)
+        if (!alocar_recursos_fase(aviao, FASE_DESEMBARQUE, 0, 1, &pista_alocada, &portao_alocado)) {
+            return 0; // falhou ou arremeteu
+        }
 
-    if (aviao->estado == CAIU || aviao->estado == ARREMETEU) {
-        return 0;
-    }
+        if (aviao->estado == CAIU || aviao->estado == ARREMETEU) {
+            return 0;
+        }
 
-    aviao->portao_alocado = portao_alocado;
+        aviao->inicio_portao_ms = get_time_ms();
 
-    // realizar desembarque
-    aviao->estado = DESEMBARCANDO;
-    safe_print("💺 Avião %d DESEMBARCANDO no portão %d!\n", aviao->id, portao_alocado);
+        // realizar desembarque
+        transicao_aviao(aviao, DESEMBARCANDO, -1, portao_alocado);
+        safe_print("💺 Avião %d DESEMBARCANDO no portão %d!\n", aviao->id, portao_alocado);
+    }
 
-    sleep(3); // tempo de desembarque
+    aguardar_operacao(aviao, TEMPO_DESEMBARQUE); // tempo de desembarque
 
     // liberar apenas a torre, manter portão para decolagem
+    concluir_operacao(aviao, AGUARDANDO_DECOLAGEM, -1, portao_alocado);
     liberar_recursos_atomicos(-1, -1, 1);
 
     safe_print("✅  Avião %d DESEMBARCOU com sucesso! Mantendo portão %d para decolagem!\n",
@@ -476,83 +1472,144 @@ int realizar_desembarque(aviao_t *aviao) {
 
 // função para operação de decolagem
 int realizar_decolagem(aviao_t *aviao) {
-    safe_print("🛫 Avião %d iniciando procedimento de DECOLAGEM!\n", aviao->id);
+    int pista_alocada = aviao->pista_alocada, portao_dummy = -1;
 
-    aviao->estado = AGUARDANDO_DECOLAGEM;
-    resetar_cronometro(aviao);
+    // avião restaurado no meio da decolagem já ocupa pista, portão e torre
+    if (aviao->estado != DECOLANDO) {
+        safe_print("🛫 Avião %d iniciando procedimento de DECOLAGEM!\n", aviao->id);
 
-    int pista_alocada = -1, portao_dummy = -1;
-
-    // alocar recursos necessários para decolagem (pista + torre)
-    // portão já está alocado do desembarque
-    if (!alocar_recursos_atomicos(aviao, 1, 0, 1, &pista_alocada, &portao_dummy)) {
-        // liberar portão se falhou
-        if (aviao->portao_alocado >= 0) {
-            liberar_recursos_atomicos(-1, aviao->portao_alocado, 0);
+        if (aviao->retomado) {
+            aviao->retomado = 0; // mantém o cronômetro de espera do checkpoint
+        } else {
+            aviao->estado = AGUARDANDO_DECOLAGEM;
+            resetar_cronometro(aviao);
         }
-        return 0; // falhou ou arremeteu
-    }
 
-    if (aviao->estado == CAIU || aviao->estado == ARREMETEU) {
-        if (aviao->portao_alocado >= 0) {
-            liberar_recursos_atomicos(-1, aviao->portao_alocado, 0);
+        // alocar recursos necessários para decolagem (pista + torre)
+        // portão já está alocado do desembarque
+        if (!alocar_recursos_fase(aviao, FASE_DECOLAGEM, 1, 0, &pista_alocada, &portao_dummy)) {
+            // liberar portão se falhou
+            if (aviao->portao_alocado >= 0) {
+                liberar_recursos_atomicos(-1, aviao->portao_alocado, 0);
+                registrar_ocupacao(&tempo_portoes_ocupados_ms, aviao->inicio_portao_ms);
+            }
+            return 0; // falhou ou arremeteu
         }
-        return 0;
-    }
 
-    aviao->pista_alocada = pista_alocada;
+        if (aviao->estado == CAIU || aviao->estado == ARREMETEU) {
+            if (aviao->portao_alocado >= 0) {
+                liberar_recursos_atomicos(-1, aviao->portao_alocado, 0);
+                registrar_ocupacao(&tempo_portoes_ocupados_ms, aviao->inicio_portao_ms);
+            }
+            return 0;
+        }
 
-    // realizar decolagem
-    aviao->estado = DECOLANDO;
-    safe_print("🛫 Avião %d DECOLANDO da pista %d, partindo do portão %d!\n",
-              aviao->id, pista_alocada, aviao->portao_alocado);
+        // realizar decolagem
+        transicao_aviao(aviao, DECOLANDO, pista_alocada, aviao->portao_alocado);
+        safe_print("🛫 Avião %d DECOLANDO da pista %d, partindo do portão %d!\n",
+                  aviao->id, pista_alocada, aviao->portao_alocado);
+    }
 
-    sleep(2); // tempo de decolagem
+    aguardar_operacao(aviao, TEMPO_DECOLAGEM); // tempo de decolagem
 
-    // liberar todos os recursos
-    liberar_recursos_atomicos(pista_alocada, aviao->portao_alocado, 1);
-    aviao->portao_alocado = -1;
-    aviao->pista_alocada = -1;
+    // liberar todos os recursos, já no estado final
+    int portao_alocado = aviao->portao_alocado;
+    registrar_ocupacao(&tempo_pistas_ocupadas_ms, aviao->inicio_operacao_ms);
+    registrar_ocupacao(&tempo_portoes_ocupados_ms, aviao->inicio_portao_ms);
+    concluir_operacao(aviao, FINALIZADO, -1, -1);
+    liberar_recursos_atomicos(pista_alocada, portao_alocado, 1);
 
     safe_print("🎉 Avião %d DECOLOU com sucesso! Todos os recursos liberados!\n", aviao->id);
 
     return 1;
 }
 
+// função para executar as operações restantes a partir do estado atual do avião
+void executar_operacoes(aviao_t *aviao) {
+    // operação 1: pouso
+    if (aviao->estado <= POUSANDO) {
+        if (!realizar_pouso(aviao)) return;
+        registrar_operacao_concluida();
+    }
+
+    // operação 2: desembarque
+    if (aviao->estado <= DESEMBARCANDO) {
+        if (!realizar_desembarque(aviao)) return;
+        registrar_operacao_concluida();
+    }
+
+    // operação 3: decolagem (termina em FINALIZADO)
+    if (!realizar_decolagem(aviao)) return;
+    registrar_operacao_concluida();
+
+    pthread_mutex_lock(&mutex_stats);
+    avioes_finalizados++;
+    soma_tempo_atendimento_ms += get_time_ms() - aviao->chegada_ms;
+    pthread_mutex_unlock(&mutex_stats);
+
+    safe_print("🏆 Avião %d CONCLUIU todas as operações com sucesso!\n", aviao->id);
+}
+
 // função principal da thread do avião
 void* thread_aviao(void* arg) {
     aviao_t* aviao = (aviao_t*)arg;
 
-    aviao->pista_alocada = -1;
-    aviao->portao_alocado = -1;
-    aviao->operacoes_concluidas = 0;
-    aviao->em_estado_critico = 0;
-    aviao->prioridade = 0;
-    aviao->tentativas_totais = 0;
+    if (aviao->retomado) {
+        // avião restaurado de um checkpoint: continua da fase em que estava
+        safe_print("♻️ Avião %d (%s) retomado do checkpoint com %d/3 operações concluídas\n",
+                  aviao->id, (aviao->tipo == INTERNACIONAL) ? "INT" : "DOM",
+                  aviao->operacoes_concluidas);
 
-    safe_print("🆕 Avião %d (%s) chegou ao aeroporto!\n",
-              aviao->id, (aviao->tipo == INTERNACIONAL) ? "INTERNACIONAL" : "DOMÉSTICO");
+        if (aviao->estado == EM_CIRCUITO) {
+            aviao->retomado = 0;
+            if (!orbitar_circuito(aviao)) {
+                return NULL;
+            }
+        }
 
-    // operação 1: pouso
-    if (realizar_pouso(aviao)) {
-        aviao->operacoes_concluidas++;
+        // no meio de uma operação o cronômetro salvo não vale para a fase seguinte
+        if (aviao->estado == POUSANDO || aviao->estado == DESEMBARCANDO || aviao->estado == DECOLANDO) {
+            aviao->retomado = 0;
+        }
 
-        // operação 2: desembarque
-        if (realizar_desembarque(aviao)) {
-            aviao->operacoes_concluidas++;
+        if (planejador_ativo) {
+            planejar_voo_retomado(aviao);
+        }
+    } else {
+        aviao->pista_alocada = -1;
+        aviao->portao_alocado = -1;
+        aviao->operacoes_concluidas = 0;
+        aviao->em_estado_critico = 0;
+        aviao->prioridade = 0;
+        aviao->tentativas_totais = 0;
+        aviao->passou_circuito = 0;
+        aviao->voltas_circuito = 0;
+        aviao->liberado_circuito = 0;
+        aviao->chegada_ms = get_time_ms();
+        aviao->inicio_portao_ms = 0;
+        aviao->inicio_operacao_ms = 0;
+        aviao->plano.valido = 0;
+        aviao->requisicao_restaurada = 0;
+
+        safe_print("🆕 Avião %d (%s) chegou ao aeroporto!\n",
+                  aviao->id, (aviao->tipo == INTERNACIONAL) ? "INTERNACIONAL" : "DOMÉSTICO");
+
+        // controle de admissão antes de iniciar o pouso
+        if (!admitir_aviao(aviao)) {
+            return NULL;
+        }
 
-            // operação 3: decolagem
-            if (realizar_decolagem(aviao)) {
-                aviao->operacoes_concluidas++;
-                aviao->estado = FINALIZADO;
+        // reservar slots para todas as fases
+        if (planejador_ativo) {
+            planejar_voo(aviao);
+        }
+    }
 
-                pthread_mutex_lock(&mutex_stats);
-                avioes_finalizados++;
-                pthread_mutex_unlock(&mutex_stats);
+    executar_operacoes(aviao);
 
-                safe_print("🏆 Avião %d CONCLUIU todas as operações com sucesso!\n", aviao->id);
-            }
-        }
+    // liberar slots que não serão mais usados
+    if (planejador_ativo) {
+        cancelar_plano(aviao);
     }
 
     return NULL;
@@ -560,35 +1617,44 @@ void* thread_aviao(void* arg) {
 
 // thread para criar aviões periodicamente
 void* thread_criador_avioes(void* arg) {
-    srand(time(NULL));
-
     while (simulacao_ativa) {
-        if (num_avioes < 1000) {
-            pthread_mutex_lock(&mutex_avioes);
+        // o estado do gerador é usado sob mutex_avioes para o checkpoint ser coerente
+        pthread_mutex_lock(&mutex_avioes);
 
-            aviao_t* novo_aviao = malloc(sizeof(aviao_t));
-            novo_aviao->id = proximo_id++;
-            novo_aviao->tipo = (rand() % 2) ? INTERNACIONAL : DOMESTICO;
-            novo_aviao->estado = AGUARDANDO_POUSO;
+        aviao_t* novo_aviao = calloc(1, sizeof(aviao_t));
+        novo_aviao->id = proximo_id++;
+        novo_aviao->tipo = (rand_r(&estado_rng) % 2) ? INTERNACIONAL : DOMESTICO;
+        novo_aviao->estado = AGUARDANDO_POUSO;
+        novo_aviao->pista_alocada = -1;
+        novo_aviao->portao_alocado = -1;
 
-            avioes[num_avioes] = novo_aviao;
-            num_avioes++;
-            total_avioes_criados++;
+        adicionar_aviao(novo_aviao);
+        total_avioes_criados++;
 
-            pthread_mutex_unlock(&mutex_avioes);
+        // intervalo randômico entre 1 e 5 segundos
+        int intervalo = 1 + rand_r(&estado_rng) % 5;
 
-            // criar thread do avião
-            pthread_create(&novo_aviao->thread, NULL, thread_aviao, novo_aviao);
-            pthread_detach(novo_aviao->thread);
-        }
+        pthread_mutex_unlock(&mutex_avioes);
 
-        // intervalo randômico entre 1 e 5 segundos
-        sleep(1 + rand() % 5);
+        // criar thread do avião
+        pthread_create(&novo_aviao->thread, NULL, thread_aviao, novo_aviao);
+        pthread_detach(novo_aviao->thread);
+
+        sleep(intervalo);
     }
 
     return NULL;
 }
 
+// função para contar recursos abertos de um tipo
+int contar_abertos(atomic_int* fechados, int quantidade) {
+    int abertos = 0;
+    for (int i = 0; i < quantidade; i++) {
+        if (!atomic_load(&fechados[i])) abertos++;
+    }
+    return abertos;
+}
+
 // thread para monitorar sistema
 void* thread_monitor(void* arg) {
     while (simulacao_ativa) {
@@ -603,6 +1669,12 @@ void* thread_monitor(void* arg) {
         safe_print("Aviões que arremeteram: %d\n", avioes_arremetidos);
         safe_print("Casos de starvation: %d\n", starvation_cases);
         safe_print("Requisições na fila: %d\n", num_requisicoes);
+        safe_print("Aviões no circuito de espera: %d\n", avioes_em_circuito);
+        safe_print("Aviões desviados: %d\n", avioes_desviados);
+        safe_print("Capacidade atual: %d/%d pistas, %d/%d portões, torre %d\n",
+                  contar_abertos(pista_fechada, NUM_PISTAS), NUM_PISTAS,
+                  contar_abertos(portao_fechado, NUM_PORTOES), NUM_PORTOES,
+                  atomic_load(&capacidade_torre));
         safe_print("================================\n");
         pthread_mutex_unlock(&mutex_stats);
     }
@@ -610,6 +1682,203 @@ void* thread_monitor(void* arg) {
     return NULL;
 }
 
+// função para replanejar na hora os voos com reservas futuras em um recurso que ficou indisponível
+int replanejar_por_capacidade(tipo_recurso_t tipo, int indice) {
+    int ids[MAX_RESERVAS];
+    fase_t fases[MAX_RESERVAS];
+    int num_afetados = 0;
+    long long agora = get_time_ms();
+    int capacidade = atomic_load(&capacidade_torre);
+
+    // reservas ainda não iniciadas no recurso afetado (operações em andamento continuam)
+    pthread_mutex_lock(&mutex_planejador);
+    for (int i = 0; i < num_reservas; i++) {
+        reserva_t* r = &reservas[i];
+        int afetada = (r->inicio_ms > agora) &&
+                      ((tipo == RECURSO_TORRE && r->recurso == RECURSO_TORRE && r->indice >= capacidade) ||
+                       (tipo != RECURSO_TORRE && r->recurso == tipo && r->indice == indice));
+        if (!afetada) continue;
+
+        int j = 0;
+        while (j < num_afetados && ids[j] != r->aviao_id) j++;
+        if (j == num_afetados) {
+            ids[num_afetados] = r->aviao_id;
+            fases[num_afetados] = r->fase;
+            num_afetados++;
+        } else if (r->fase < fases[j]) {
+            fases[j] = r->fase;
+        }
+    }
+    pthread_mutex_unlock(&mutex_planejador);
+
+    if (num_afetados == 0) return 0;
+
+    // localizar os aviões afetados
+    aviao_t* afetados[MAX_RESERVAS];
+    memset(afetados, 0, num_afetados * sizeof(aviao_t*));
+
+    pthread_mutex_lock(&mutex_avioes);
+    for (int i = num_avioes - 1; i >= 0; i--) {
+        for (int j = 0; j < num_afetados; j++) {
+            if (avioes[i]->id == ids[j]) afetados[j] = avioes[i];
+        }
+    }
+    pthread_mutex_unlock(&mutex_avioes);
+
+    // replanejar a partir da primeira fase afetada e acordar quem espera pelo slot
+    int replanejados = 0;
+    pthread_mutex_lock(&mutex_planejador);
+    for (int j = 0; j < num_afetados; j++) {
+        aviao_t* aviao = afetados[j];
+        if (aviao == NULL || !aviao->plano.valido) continue;
+
+        planejar_fases(aviao, fases[j], get_time_ms());
+        replanejados++;
+    }
+    pthread_cond_broadcast(&cond_planejador);
+    pthread_mutex_unlock(&mutex_planejador);
+
+    pthread_mutex_lock(&mutex_stats);
+    replanejamentos += replanejados;
+    pthread_mutex_unlock(&mutex_stats);
+
+    return replanejados;
+}
+
+// função para aplicar um evento de capacidade sem parar a simulação: só muda estado atômico
+// (mutex_recursos é travado apenas para acordar quem espera). Voos ocupando um recurso fechado concluem a operação em andamento
+// e o liberam normalmente; o recurso fechado apenas deixa de ser concedido. Redução da torre
+// abaixo da ocupação atual funciona da mesma forma: novas concessões esperam a torre esvaziar.
+int aplicar_evento_capacidade(const char* acao, const char* recurso, int valor) {
+    long long inicio_us = get_time_us();
+    int afetados = 0, replanejados = 0;
+    char descricao[64];
+
+    if (strcmp(acao, "torre") == 0) {
+        if (valor < 0 || valor > MAX_CAPACIDADE_TORRE) return 0;
+
+        int anterior = atomic_exchange(&capacidade_torre, valor);
+        int livre = atomic_fetch_add(&torre_livre, valor - anterior) + (valor - anterior);
+        afetados = (livre < 0) ? -livre : 0;
+        snprintf(descricao, sizeof(descricao), "torre: capacidade %d -> %d", anterior, valor);
+
+        if (valor < anterior && planejador_ativo) {
+            replanejados = replanejar_por_capacidade(RECURSO_TORRE, -1);
+        }
+    } else {
+        int fechar = strcmp(acao, "fechar") == 0;
+        if (!fechar && strcmp(acao, "abrir") != 0) return 0;
+
+        tipo_recurso_t tipo;
+        atomic_int* fechados;
+        if (strcmp(recurso, "pista") == 0 && valor >= 0 && valor < NUM_PISTAS) {
+            tipo = RECURSO_PISTA;
+            fechados = pista_fechada;
+        } else if (strcmp(recurso, "portao") == 0 && valor >= 0 && valor < NUM_PORTOES) {
+            tipo = RECURSO_PORTAO;
+            fechados = portao_fechado;
+        } else {
+            return 0;
+        }
+
+        atomic_store(&fechados[valor], fechar);
+        snprintf(descricao, sizeof(descricao), "%s %s %d", fechar ? "fechar" : "abrir", recurso, valor);
+
+        if (fechar) {
+            // voos que estão com o recurso concluem a operação
+            pthread_mutex_lock(&mutex_avioes);
+            for (int i = 0; i < num_avioes; i++) {
+                aviao_t* aviao = avioes[i];
+                if (estado_terminal(aviao->estado)) continue;
+                if ((tipo == RECURSO_PISTA && aviao->pista_alocada == valor &&
+                     (aviao->estado == POUSANDO || aviao->estado == DECOLANDO)) ||
+                    (tipo == RECURSO_PORTAO && aviao->portao_alocado == valor &&
+                     aviao->estado >= DESEMBARCANDO && aviao->estado <= DECOLANDO)) {
+                    afetados++;
+                }
+            }
+            pthread_mutex_unlock(&mutex_avioes);
+
+            if (planejador_ativo) {
+                replanejados = replanejar_por_capacidade(tipo, valor);
+            }
+        }
+    }
+
+    // quem espera por recursos volta a verificar a disponibilidade (um evento conta como liberação)
+    pthread_mutex_lock(&mutex_recursos);
+    atomic_store(&ultima_liberacao_us, get_time_us());
+    notificar_recursos();
+    pthread_mutex_unlock(&mutex_recursos);
+
+    long long aplicacao_us = get_time_us() - inicio_us;
+
+    pthread_mutex_lock(&mutex_stats);
+    if (num_eventos < MAX_EVENTOS) {
+        evento_capacidade_t* e = &eventos[num_eventos++];
+        e->instante_ms = get_time_ms();
+        e->aplicacao_us = aplicacao_us;
+        e->voos_afetados = afetados;
+        e->voos_replanejados = replanejados;
+        snprintf(e->descricao, sizeof(e->descricao), "%s", descricao);
+    }
+    pthread_mutex_unlock(&mutex_stats);
+
+    safe_print("🚧 EVENTO DE CAPACIDADE: %s (%d voo(s) concluem a operação em andamento, %d replanejado(s), aplicado em %lld µs)\n",
+              descricao, afetados, replanejados, aplicacao_us);
+
+    return 1;
+}
+
+// thread para aplicar eventos de capacidade lidos de um roteiro (arquivo ou entrada padrão)
+// formato de cada linha: <segundos desde o início da execução> <ação>, com ação
+//   fechar pista N | abrir pista N | fechar portao N | abrir portao N | torre N
+void* thread_eventos(void* arg) {
+    FILE* roteiro = (FILE*)arg;
+    char linha[256];
+
+    while (simulacao_ativa && fgets(linha, sizeof(linha), roteiro) != NULL) {
+        double segundos;
+        char acao[16], recurso[16];
+        int valor = -1;
+
+        if (linha[0] == '#' || linha[0] == '\n') continue;
+
+        int campos = sscanf(linha, "%lf %15s %15s %d", &segundos, acao, recurso, &valor);
+        if (campos >= 3 && strcmp(acao, "torre") == 0) {
+            // capacidade precisa ser um número: "torre x" não pode virar capacidade 0
+            char* fim;
+            long capacidade = strtol(recurso, &fim, 10);
+            if (fim == recurso || *fim != '\0' || capacidade < 0 || capacidade > MAX_CAPACIDADE_TORRE) {
+                safe_print("⚠️ Evento ignorado (capacidade da torre inválida): %s", linha);
+                continue;
+            }
+            valor = (int)capacidade;
+        } else if (campos != 4) {
+            safe_print("⚠️ Evento ignorado (formato inválido): %s", linha);
+            continue;
+        }
+
+        // aguardar o instante do evento (eventos no passado são aplicados na hora)
+        long long instante_ms = inicio_execucao_ms + (long long)(segundos * 1000);
+        while (simulacao_ativa && get_time_ms() < instante_ms) {
+            long long restante_ms = instante_ms - get_time_ms();
+            usleep((restante_ms > 500 ? 500 : restante_ms) * 1000);
+        }
+        if (!simulacao_ativa) break;
+
+        if (!aplicar_evento_capacidade(acao, recurso, valor)) {
+            safe_print("⚠️ Evento ignorado (recurso ou ação inválida): %s", linha);
+        }
+    }
+
+    if (roteiro != stdin) {
+        fclose(roteiro);
+    }
+
+    return NULL;
+}
+
 // função para inicializar recursos
 void inicializar_recursos() {
     // inicializar semáforos das pistas
@@ -621,36 +1890,523 @@ void inicializar_recursos() {
     for (int i = 0; i < NUM_PORTOES; i++) {
         sem_init(&portoes[i], 0, 1);
     }
+
+#if SINCRONIZACAO_FUTEX
+    // mutex adaptativo: gira brevemente antes de dormir, adequado a seções críticas curtas
+    if (sincronizacao_futex) {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+        pthread_mutex_init(&mutex_recursos, &attr);
+        pthread_mutexattr_destroy(&attr);
+    }
+#endif
+}
+
+// função para calcular há quanto tempo ocorreu um instante (0 se o instante não foi registrado)
+int32_t tempo_desde_ms(long long agora, long long instante_ms) {
+    return (instante_ms > 0) ? (int32_t)(agora - instante_ms) : 0;
+}
+
+// função para salvar o estado completo da simulação em um arquivo de checkpoint
+int salvar_checkpoint(const char* arquivo) {
+    long long inicio_ms = get_time_ms();
+
+    // parar o mundo: lista de aviões, fila de requisições e estatísticas
+    pthread_mutex_lock(&mutex_avioes);
+    pthread_mutex_lock(&mutex_recursos);
+    pthread_mutex_lock(&mutex_stats);
+
+    long long agora = get_time_ms();
+    struct timeval agora_tv;
+    gettimeofday(&agora_tv, NULL);
+
+    cabecalho_checkpoint_t cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magico, CHECKPOINT_MAGICO, 4);
+    cab.versao = CHECKPOINT_VERSAO;
+    cab.ordem_bytes = CHECKPOINT_ORDEM_BYTES;
+    cab.tempo_decorrido_ms = agora - inicio_simulacao_ms;
+    cab.tempo_pistas_ocupadas_ms = tempo_pistas_ocupadas_ms;
+    cab.tempo_portoes_ocupados_ms = tempo_portoes_ocupados_ms;
+    cab.soma_tempo_atendimento_ms = soma_tempo_atendimento_ms;
+    cab.soma_latencia_despertar_us = soma_latencia_despertar_us;
+    cab.estado_rng = estado_rng;
+    cab.num_pistas = NUM_PISTAS;
+    cab.num_portoes = NUM_PORTOES;
+    cab.max_torre_operacoes = MAX_TORRE_OPERACOES;
+    cab.proximo_id = proximo_id;
+    cab.total_avioes_criados = total_avioes_criados;
+    cab.avioes_finalizados = avioes_finalizados;
+    cab.avioes_caidos = avioes_caidos;
+    cab.avioes_arremetidos = avioes_arremetidos;
+    cab.starvation_cases = starvation_cases;
+    cab.avioes_circuito_total = avioes_circuito_total;
+    cab.avioes_desviados = avioes_desviados;
+    cab.replanejamentos = replanejamentos;
+    cab.voos_sem_plano = voos_sem_plano;
+    cab.despertares_por_liberacao = despertares_por_liberacao;
+    cab.num_avioes = num_avioes;
+    cab.num_requisicoes = num_requisicoes;
+    for (int i = 0; i < NUM_PISTAS; i++) {
+        if (atomic_load(&pista_fechada[i])) cab.pistas_fechadas |= 1u << i;
+    }
+    for (int i = 0; i < NUM_PORTOES; i++) {
+        if (atomic_load(&portao_fechado[i])) cab.portoes_fechados |= 1u << i;
+    }
+    cab.capacidade_torre = atomic_load(&capacidade_torre);
+
+    // ocupação dos recursos, derivada do estado dos aviões (coerente com os registros)
+    int32_t ocupacao[NUM_PISTAS + NUM_PORTOES + 1];
+    memset(ocupacao, 0, sizeof(ocupacao));
+
+    registro_aviao_t* registros = malloc((num_avioes > 0 ? num_avioes : 1) * sizeof(registro_aviao_t));
+    for (int i = 0; i < num_avioes; i++) {
+        aviao_t* aviao = avioes[i];
+        registro_aviao_t* r = &registros[i];
+
+        r->id = aviao->id;
+        r->prioridade = aviao->prioridade;
+        r->tentativas_totais = aviao->tentativas_totais;
+        r->tempo_espera_total = aviao->tempo_espera_total;
+        r->espera_ms = (agora_tv.tv_sec - aviao->inicio_espera.tv_sec) * 1000 +
+                       (agora_tv.tv_usec - aviao->inicio_espera.tv_usec) / 1000;
+        r->desde_chegada_ms = tempo_desde_ms(agora, aviao->chegada_ms);
+        r->desde_portao_ms = tempo_desde_ms(agora, aviao->inicio_portao_ms);
+        r->desde_operacao_ms = tempo_desde_ms(agora, aviao->inicio_operacao_ms);
+        r->tipo = aviao->tipo;
+        r->estado = aviao->estado;
+        r->operacoes_concluidas = aviao->operacoes_concluidas;
+        r->pista_alocada = aviao->pista_alocada;
+        r->portao_alocado = aviao->portao_alocado;
+        r->em_estado_critico = aviao->em_estado_critico;
+        r->passou_circuito = aviao->passou_circuito;
+        r->voltas_circuito = aviao->voltas_circuito;
+
+        // índices negativos (recurso não alocado) nunca indexam a tabela
+        int ocupa_pista = aviao->pista_alocada >= 0 &&
+                          (aviao->estado == POUSANDO || aviao->estado == DECOLANDO);
+        int ocupa_portao = aviao->portao_alocado >= 0 &&
+                           aviao->estado >= DESEMBARCANDO && aviao->estado <= DECOLANDO;
+        int ocupa_torre = aviao->estado == POUSANDO || aviao->estado == DESEMBARCANDO ||
+                          aviao->estado == DECOLANDO;
+
+        if (ocupa_pista) ocupacao[aviao->pista_alocada] = aviao->id;
+        if (ocupa_portao) ocupacao[NUM_PISTAS + aviao->portao_alocado] = aviao->id;
+        if (ocupa_torre) ocupacao[NUM_PISTAS + NUM_PORTOES]++;
+    }
+
+    registro_requisicao_t* fila = malloc((num_requisicoes > 0 ? num_requisicoes : 1) * sizeof(registro_requisicao_t));
+    for (int i = 0; i < num_requisicoes; i++) {
+        requisicao_t* req = fila_requisicoes[i];
+        fila[i].aviao_id = req->aviao_id;
+        fila[i].prioridade = req->prioridade;
+        fila[i].tentativas = req->tentativas;
+        fila[i].idade_ms = (agora_tv.tv_sec - req->timestamp.tv_sec) * 1000 +
+                           (agora_tv.tv_usec - req->timestamp.tv_usec) / 1000;
+    }
+
+    pthread_mutex_unlock(&mutex_stats);
+    pthread_mutex_unlock(&mutex_recursos);
+    pthread_mutex_unlock(&mutex_avioes);
+
+    // gravar em arquivo temporário e renomear, para nunca deixar um checkpoint pela metade
+    char temporario[4096];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", arquivo);
+
+    FILE* f = fopen(temporario, "wb");
+    int ok = f != NULL &&
+             fwrite(&cab, sizeof(cab), 1, f) == 1 &&
+             fwrite(ocupacao, sizeof(ocupacao), 1, f) == 1 &&
+             fwrite(registros, sizeof(registro_aviao_t), cab.num_avioes, f) == (size_t)cab.num_avioes &&
+             fwrite(fila, sizeof(registro_requisicao_t), cab.num_requisicoes, f) == (size_t)cab.num_requisicoes;
+    if (f != NULL && fclose(f) != 0) ok = 0;
+    if (ok && rename(temporario, arquivo) != 0) ok = 0;
+
+    free(registros);
+    free(fila);
+
+    if (!ok) {
+        safe_print("❌ Falha ao gravar checkpoint em %s\n", arquivo);
+        remove(temporario);
+        return 0;
+    }
+
+    safe_print("💾 Checkpoint salvo em %s: %d aviões, %d requisições na fila (%lld ms)\n",
+              arquivo, cab.num_avioes, cab.num_requisicoes, get_time_ms() - inicio_ms);
+    return 1;
+}
+
+// função para restaurar o estado da simulação de um arquivo de checkpoint
+// (chamar após inicializar_recursos e antes de criar as threads auxiliares)
+int restaurar_checkpoint(const char* arquivo) {
+    long long inicio_ms = get_time_ms();
+
+    FILE* f = fopen(arquivo, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "Não foi possível abrir o checkpoint %s\n", arquivo);
+        return 0;
+    }
+
+    cabecalho_checkpoint_t cab;
+    memset(&cab, 0, sizeof(cab));
+    if (fread(&cab, TAMANHO_CABECALHO_V1, 1, f) != 1 || memcmp(cab.magico, CHECKPOINT_MAGICO, 4) != 0) {
+        fprintf(stderr, "Arquivo %s não é um checkpoint válido\n", arquivo);
+        fclose(f);
+        return 0;
+    }
+
+    if (cab.ordem_bytes != CHECKPOINT_ORDEM_BYTES || cab.versao < 1 || cab.versao > CHECKPOINT_VERSAO) {
+        fprintf(stderr, "Checkpoint %s incompatível (versão %u, esperada até %d)\n",
+                arquivo, cab.versao, CHECKPOINT_VERSAO);
+        fclose(f);
+        return 0;
+    }
+
+    // versão 1 não tem estado de capacidade: todos os recursos abertos, torre sem mudança por eventos
+    if (cab.versao == 1) {
+        cab.capacidade_torre = cab.max_torre_operacoes;
+    } else if (fread((char*)&cab + TAMANHO_CABECALHO_V1, sizeof(cab) - TAMANHO_CABECALHO_V1, 1, f) != 1) {
+        fprintf(stderr, "Arquivo %s não é um checkpoint válido\n", arquivo);
+        fclose(f);
+        return 0;
+    }
+
+    // contagens do cabeçalho precisam ser não negativas e caber exatamente no restante do arquivo
+    long posicao = ftell(f);
+    fseek(f, 0, SEEK_END);
+    long long restante = (long long)ftell(f) - posicao;
+    fseek(f, posicao, SEEK_SET);
+
+    if (cab.num_pistas < 0 || cab.num_portoes < 0 || cab.num_avioes < 0 || cab.num_requisicoes < 0 ||
+        cab.num_requisicoes > MAX_REQUISICOES || cab.proximo_id < 0 ||
+        cab.capacidade_torre < 0 || cab.capacidade_torre > MAX_CAPACIDADE_TORRE ||
+        cab.max_torre_operacoes < 0 || cab.max_torre_operacoes > MAX_CAPACIDADE_TORRE ||
+        restante != ((long long)cab.num_pistas + cab.num_portoes + 1) * (long long)sizeof(int32_t) +
+                    (long long)cab.num_avioes * (long long)sizeof(registro_aviao_t) +
+                    (long long)cab.num_requisicoes * (long long)sizeof(registro_requisicao_t)) {
+        fprintf(stderr, "Checkpoint %s corrompido (contagens incompatíveis com o tamanho do arquivo)\n", arquivo);
+        fclose(f);
+        return 0;
+    }
+
+    int num_recursos = cab.num_pistas + cab.num_portoes + 1;
+    int32_t* ocupacao = malloc(num_recursos * sizeof(int32_t));
+    registro_aviao_t* registros = malloc((cab.num_avioes > 0 ? cab.num_avioes : 1) * sizeof(registro_aviao_t));
+    registro_requisicao_t* fila = malloc((cab.num_requisicoes > 0 ? cab.num_requisicoes : 1) * sizeof(registro_requisicao_t));
+
+    int ok = fread(ocupacao, sizeof(int32_t), num_recursos, f) == (size_t)num_recursos &&
+             fread(registros, sizeof(registro_aviao_t), cab.num_avioes, f) == (size_t)cab.num_avioes &&
+             fread(fila, sizeof(registro_requisicao_t), cab.num_requisicoes, f) == (size_t)cab.num_requisicoes;
+    fclose(f);
+
+    // a configuração pode mudar, mas os recursos ocupados precisam existir
+    for (int i = 0; ok && i < cab.num_pistas; i++) {
+        if (ocupacao[i] != 0 && i >= NUM_PISTAS) ok = 0;
+    }
+    int maior_id = 0;
+    for (int i = 0; ok && i < cab.num_avioes; i++) {
+        registro_aviao_t* r = &registros[i];
+        if (r->id > maior_id) maior_id = r->id;
+        if (r->id <= 0 || r->estado < AGUARDANDO_POUSO || r->estado > DESVIADO ||
+            r->pista_alocada < -1 || r->pista_alocada >= NUM_PISTAS ||
+            r->portao_alocado < -1 || r->portao_alocado >= NUM_PORTOES) ok = 0;
+    }
+    for (int i = 0; ok && i < cab.num_portoes; i++) {
+        if (ocupacao[cab.num_pistas + i] != 0 && i >= NUM_PORTOES) ok = 0;
+    }
+
+    // ids são atribuídos em sequência e todo avião criado fica na lista: proximo_id é o maior id + 1
+    // (limita o índice por id montado abaixo)
+    if (ok && cab.proximo_id > (long long)maior_id + 1) ok = 0;
+
+    if (!ok) {
+        fprintf(stderr, "Checkpoint %s truncado ou incompatível com a configuração atual\n", arquivo);
+        free(ocupacao);
+        free(registros);
+        free(fila);
+        return 0;
+    }
+
+    long long agora = get_time_ms();
+    struct timeval agora_tv;
+    gettimeofday(&agora_tv, NULL);
+
+    // estatísticas e estado global
+    inicio_simulacao_ms = agora - cab.tempo_decorrido_ms;
+    tempo_pistas_ocupadas_ms = cab.tempo_pistas_ocupadas_ms;
+    tempo_portoes_ocupados_ms = cab.tempo_portoes_ocupados_ms;
+    soma_tempo_atendimento_ms = cab.soma_tempo_atendimento_ms;
+    soma_latencia_despertar_us = cab.soma_latencia_despertar_us;
+    estado_rng = cab.estado_rng;
+    proximo_id = cab.proximo_id;
+    total_avioes_criados = cab.total_avioes_criados;
+    avioes_finalizados = cab.avioes_finalizados;
+    avioes_caidos = cab.avioes_caidos;
+    avioes_arremetidos = cab.avioes_arremetidos;
+    starvation_cases = cab.starvation_cases;
+    avioes_circuito_total = cab.avioes_circuito_total;
+    avioes_desviados = cab.avioes_desviados;
+    replanejamentos = cab.replanejamentos;
+    voos_sem_plano = cab.voos_sem_plano;
+    despertares_por_liberacao = cab.despertares_por_liberacao;
+
+    // ocupação dos recursos
+    for (int i = 0; i < cab.num_pistas; i++) {
+        if (ocupacao[i] != 0) sem_trywait(&pistas[i]);
+    }
+    for (int i = 0; i < cab.num_portoes; i++) {
+        if (ocupacao[cab.num_pistas + i] != 0) sem_trywait(&portoes[i]);
+    }
+    // só a mudança feita por eventos é levada adiante, sobre o limite da torre desta compilação
+    long long capacidade = (long long)MAX_TORRE_OPERACOES + cab.capacidade_torre - cab.max_torre_operacoes;
+    if (capacidade < 0) capacidade = 0;
+    if (capacidade > MAX_CAPACIDADE_TORRE) capacidade = MAX_CAPACIDADE_TORRE;
+    atomic_store(&capacidade_torre, capacidade);
+    atomic_store(&torre_livre, capacidade - ocupacao[cab.num_pistas + cab.num_portoes]);
+
+    // recursos fechados por eventos antes do checkpoint
+    for (int i = 0; i < NUM_PISTAS; i++) {
+        atomic_store(&pista_fechada[i], i < cab.num_pistas && (cab.pistas_fechadas >> i) & 1);
+    }
+    for (int i = 0; i < NUM_PORTOES; i++) {
+        atomic_store(&portao_fechado[i], i < cab.num_portoes && (cab.portoes_fechados >> i) & 1);
+    }
+
+    // aviões (índice por id para associar as requisições da fila)
+    aviao_t** por_id = calloc(cab.proximo_id + 1, sizeof(aviao_t*));
+    if (por_id == NULL) {
+        fprintf(stderr, "Memória insuficiente para restaurar o checkpoint %s\n", arquivo);
+        free(ocupacao);
+        free(registros);
+        free(fila);
+        return 0;
+    }
+    int ativos = 0;
+
+    pthread_mutex_lock(&mutex_avioes);
+    capacidade_avioes = cab.num_avioes > 1024 ? cab.num_avioes : 1024;
+    avioes = realloc(avioes, capacidade_avioes * sizeof(aviao_t*));
+    num_avioes = 0;
+
+    for (int i = 0; i < cab.num_avioes; i++) {
+        registro_aviao_t* r = &registros[i];
+        aviao_t* aviao = calloc(1, sizeof(aviao_t));
+
+        aviao->id = r->id;
+        aviao->tipo = r->tipo;
+        aviao->estado = r->estado;
+        aviao->prioridade = r->prioridade;
+        aviao->tentativas_totais = r->tentativas_totais;
+        aviao->tempo_espera_total = r->tempo_espera_total;
+        aviao->operacoes_concluidas = r->operacoes_concluidas;
+        aviao->pista_alocada = r->pista_alocada;
+        aviao->portao_alocado = r->portao_alocado;
+        aviao->em_estado_critico = r->em_estado_critico;
+        aviao->passou_circuito = r->passou_circuito;
+        aviao->voltas_circuito = r->voltas_circuito;
+        aviao->chegada_ms = agora - r->desde_chegada_ms;
+        aviao->inicio_portao_ms = agora - r->desde_portao_ms;
+        aviao->inicio_operacao_ms = agora - r->desde_operacao_ms;
+
+        long long inicio_espera_us = (long long)agora_tv.tv_sec * 1000000 + agora_tv.tv_usec -
+                                     (long long)r->espera_ms * 1000;
+        aviao->inicio_espera.tv_sec = inicio_espera_us / 1000000;
+        aviao->inicio_espera.tv_usec = inicio_espera_us % 1000000;
+
+        if (!estado_terminal(aviao->estado)) {
+            aviao->retomado = 1;
+            ativos++;
+        }
+
+        if (aviao->id > 0 && aviao->id <= cab.proximo_id) {
+            por_id[aviao->id] = aviao;
+        }
+        adicionar_aviao(aviao);
+    }
+    pthread_mutex_unlock(&mutex_avioes);
+
+    // fila de requisições: os aviões retomados voltam à fila com o timestamp original
+    for (int i = 0; i < cab.num_requisicoes; i++) {
+        registro_requisicao_t* r = &fila[i];
+        if (r->aviao_id <= 0 || r->aviao_id > cab.proximo_id || por_id[r->aviao_id] == NULL) continue;
+
+        aviao_t* aviao = por_id[r->aviao_id];
+        long long timestamp_us = (long long)agora_tv.tv_sec * 1000000 + agora_tv.tv_usec -
+                                 (long long)r->idade_ms * 1000;
+        aviao->timestamp_requisicao.tv_sec = timestamp_us / 1000000;
+        aviao->timestamp_requisicao.tv_usec = timestamp_us % 1000000;
+        aviao->requisicao_restaurada = 1;
+    }
+
+    free(por_id);
+    free(ocupacao);
+    free(registros);
+    free(fila);
+
+    safe_print("♻️ Checkpoint %s restaurado: %d aviões (%d ativos), %d requisições na fila, %.1f s de simulação (%lld ms)\n",
+              arquivo, cab.num_avioes, ativos, cab.num_requisicoes,
+              cab.tempo_decorrido_ms / 1000.0, get_time_ms() - inicio_ms);
+
+    // retomar as threads dos aviões ativos
+    for (int i = 0; i < num_avioes; i++) {
+        aviao_t* aviao = avioes[i];
+        if (!aviao->retomado) continue;
+
+        if (aviao->estado == EM_CIRCUITO) {
+            pthread_mutex_lock(&mutex_admissao);
+            avioes_em_circuito++;
+            pthread_mutex_unlock(&mutex_admissao);
+        }
+
+        pthread_create(&aviao->thread, NULL, thread_aviao, aviao);
+        pthread_detach(aviao->thread);
+    }
+
+    return 1;
 }
 
 // função para gerar relatório final
 void gerar_relatorio_final() {
     safe_print("================================\n");
     safe_print("🎯 RELATÓRIO FINAL\n");
-    safe_print("⏰  Tempo total de simulação: %d segundos\n", TEMPO_SIMULACAO);
+    safe_print("⏰  Tempo total de simulação: %d segundos\n", duracao_simulacao);
     safe_print("✈️ Total de aviões criados: %d\n", total_avioes_criados);
     safe_print("✅  Aviões que completaram todas operações: %d\n", avioes_finalizados);
     safe_print("💥 Aviões que caíram (starvation): %d\n", avioes_caidos);
     safe_print("🛫 Aviões que arremetaram: %d\n", avioes_arremetidos);
     safe_print("⚠️ Total de casos de starvation: %d\n", starvation_cases);
+    safe_print("🌀 Aviões que passaram pelo circuito de espera: %d\n", avioes_circuito_total);
+    safe_print("↪️ Aviões desviados: %d\n", avioes_desviados);
     safe_print("================================\n");
 
     double taxa_sucesso = (total_avioes_criados > 0) ?
         (double)avioes_finalizados / total_avioes_criados * 100.0 : 0.0;
     safe_print("📈 Taxa de sucesso: %.2f%%\n", taxa_sucesso);
 
+    int admitidos = total_avioes_criados - avioes_desviados;
+    double taxa_admitidos = (admitidos > 0) ?
+        (double)avioes_finalizados / admitidos * 100.0 : 0.0;
+    safe_print("📈 Taxa de sucesso dos admitidos: %.2f%%\n", taxa_admitidos);
+
     safe_print("================================\n");
     safe_print("📋 CONFIGURAÇÃO DO AEROPORTO:\n");
     safe_print("🛣️Pistas disponíveis: %d\n", NUM_PISTAS);
     safe_print("🚪 Portões disponíveis: %d\n", NUM_PORTOES);
     safe_print("🗼 Operações simultâneas na torre: %d\n", MAX_TORRE_OPERACOES);
     safe_print("🔄 Máximo de tentativas por avião: %d\n", MAX_TENTATIVAS);
+    safe_print("🌀 Circuito de espera: até %d aviões, %d voltas de %d segundos\n",
+              MAX_CIRCUITO_ESPERA, MAX_VOLTAS_CIRCUITO, TEMPO_VOLTA_CIRCUITO);
+    safe_print("🚦 Admissão: fila < %d requisições e ocupação < %d%%\n",
+              LIMITE_FILA_ADMISSAO, LIMITE_OCUPACAO_ADMISSAO);
+    safe_print("🗓️ Política de alocação: %s\n",
+              planejador_ativo ? "planejador de reservas de slots" : "contenção por prioridade");
+    safe_print("🔐 Sincronização: %s\n",
+              sincronizacao_futex ? "spin + futex" : "pthread (mutex + variável de condição)");
     safe_print("================================\n");
 
+    // desempenho da alocação (permite comparar o planejador com a contenção)
+    long long duracao_ms = get_time_ms() - inicio_simulacao_ms;
+    double utilizacao_pistas = (duracao_ms > 0) ?
+        (double)tempo_pistas_ocupadas_ms / (NUM_PISTAS * duracao_ms) * 100.0 : 0.0;
+    double utilizacao_portoes = (duracao_ms > 0) ?
+        (double)tempo_portoes_ocupados_ms / (NUM_PORTOES * duracao_ms) * 100.0 : 0.0;
+    double atendimento_medio = (avioes_finalizados > 0) ?
+        (double)soma_tempo_atendimento_ms / avioes_finalizados / 1000.0 : 0.0;
+
+    safe_print("📐 DESEMPENHO DA ALOCAÇÃO:\n");
+    safe_print("🛣️Utilização das pistas: %.2f%%\n", utilizacao_pistas);
+    safe_print("🚪 Utilização dos portões: %.2f%%\n", utilizacao_portoes);
+    safe_print("⏱️ Tempo médio de atendimento (chegada até decolagem): %.2f segundos\n", atendimento_medio);
+    if (planejador_ativo) {
+        safe_print("🗓️ Replanejamentos por atraso: %d\n", replanejamentos);
+        safe_print("🗓️ Voos sem plano (alocação por contenção): %d\n", voos_sem_plano);
+    }
+    double latencia_media = (despertares_por_liberacao > 0) ?
+        (double)soma_latencia_despertar_us / despertares_por_liberacao : 0.0;
+    safe_print("⚡ Latência média entre liberação e despertar: %.1f µs (%d despertares)\n",
+              latencia_media, despertares_por_liberacao);
+    safe_print("================================\n");
+
+    // eventos de capacidade: queda de vazão e tempo até recuperar
+    if (num_eventos > 0) {
+        // só o período com chegadas: a drenagem final reduziria a vazão por si só
+        int segundos_execucao = duracao_simulacao;
+        if (segundos_execucao > MAX_SEGUNDOS_VAZAO) segundos_execucao = MAX_SEGUNDOS_VAZAO;
+
+        safe_print("🚧 EVENTOS DE CAPACIDADE (%d):\n", num_eventos);
+        for (int i = 0; i < num_eventos; i++) {
+            evento_capacidade_t* e = &eventos[i];
+            int segundo_evento = (e->instante_ms - inicio_execucao_ms) / 1000;
+
+            // vazão média (operações/s) na janela anterior ao evento
+            int inicio_janela = segundo_evento - JANELA_VAZAO;
+            if (inicio_janela < 0) inicio_janela = 0;
+            int soma = 0;
+            for (int s = inicio_janela; s < segundo_evento; s++) soma += operacoes_por_segundo[s];
+            double vazao_antes = (segundo_evento > inicio_janela) ?
+                (double)soma / (segundo_evento - inicio_janela) : 0.0;
+
+            // menor média móvel depois do evento
+            double vazao_minima = -1.0;
+            int segundo_minimo = segundo_evento;
+            for (int s = segundo_evento; s + JANELA_RECUPERACAO <= segundos_execucao; s++) {
+                int soma_janela = 0;
+                for (int k = s; k < s + JANELA_RECUPERACAO; k++) soma_janela += operacoes_por_segundo[k];
+                double media = (double)soma_janela / JANELA_RECUPERACAO;
+
+                if (vazao_minima < 0 || media < vazao_minima) {
+                    vazao_minima = media;
+                    segundo_minimo = s;
+                }
+            }
+
+            // sem queda abaixo do limiar não há o que recuperar; senão, primeira janela a partir
+            // do mínimo que volta ao patamar anterior
+            int sem_queda = vazao_minima >= 0 && vazao_minima * 100.0 >= vazao_antes * LIMIAR_RECUPERACAO;
+            int segundo_recuperado = -1;
+            for (int s = segundo_minimo; !sem_queda && vazao_minima >= 0 &&
+                                         s + JANELA_RECUPERACAO <= segundos_execucao; s++) {
+                int soma_janela = 0;
+                for (int k = s; k < s + JANELA_RECUPERACAO; k++) soma_janela += operacoes_por_segundo[k];
+
+                if ((double)soma_janela / JANELA_RECUPERACAO * 100.0 >= vazao_antes * LIMIAR_RECUPERACAO) {
+                    segundo_recuperado = s + JANELA_RECUPERACAO;
+                    break;
+                }
+            }
+
+            safe_print("🚧 %+.1fs %s: aplicado em %lld µs, %d voo(s) afetado(s), %d replanejado(s)\n",
+                      (e->instante_ms - inicio_execucao_ms) / 1000.0, e->descricao,
+                      e->aplicacao_us, e->voos_afetados, e->voos_replanejados);
+            if (vazao_minima < 0) {
+                safe_print("   Vazão: %.2f ops/s antes; execução curta demais para medir a queda\n", vazao_antes);
+            } else if (sem_queda) {
+                safe_print("   Vazão: %.2f ops/s antes, mínima %.2f ops/s (sem queda; recuperação em 0 segundos)\n",
+                          vazao_antes, vazao_minima);
+            } else {
+                double queda = (vazao_antes > 0) ? (1.0 - vazao_minima / vazao_antes) * 100.0 : 0.0;
+                if (queda < 0) queda = 0;
+                safe_print("   Vazão: %.2f ops/s antes, mínima %.2f ops/s (queda de %.1f%%)\n",
+                          vazao_antes, vazao_minima, queda);
+                if (segundo_recuperado >= 0) {
+                    safe_print("   Recuperação a %d%% da vazão anterior em %d segundos\n",
+                              LIMIAR_RECUPERACAO, segundo_recuperado - segundo_evento);
+                } else {
+                    safe_print("   Vazão não recuperou %d%% do patamar anterior até o fim da execução\n",
+                              LIMIAR_RECUPERACAO);
+                }
+            }
+        }
+        safe_print("================================\n");
+    }
+
     safe_print("📊 ESTADO FINAL DOS AVIÕES:\n");
     pthread_mutex_lock(&mutex_avioes);
 
     int aguardando = 0, operando = 0;
+    int circuito_finalizados = 0, circuito_caidos = 0, circuito_arremetidos = 0;
+    int circuito_desviados = 0, circuito_em_andamento = 0;
     for (int i = 0; i < num_avioes; i++) {
         aviao_t* aviao = avioes[i];
         const char* tipo_str = (aviao->tipo == INTERNACIONAL) ? "INT" : "DOM";
@@ -666,6 +2422,19 @@ void gerar_relatorio_final() {
             case FINALIZADO: estado_str = "Finalizado"; break;
             case CAIU: estado_str = "Caiu"; break;
             case ARREMETEU: estado_str = "Arremeteu"; break;
+            case EM_CIRCUITO: estado_str = "Em Circuito de Espera"; aguardando++; break;
+            case DESVIADO: estado_str = "Desviado"; break;
+        }
+
+        // desfechos dos aviões que passaram pelo circuito de espera
+        if (aviao->passou_circuito) {
+            switch (aviao->estado) {
+                case FINALIZADO: circuito_finalizados++; break;
+                case CAIU: circuito_caidos++; break;
+                case ARREMETEU: circuito_arremetidos++; break;
+                case DESVIADO: circuito_desviados++; break;
+                default: circuito_em_andamento++; break;
+            }
         }
 
         safe_print("Avião %d (%s): %s - Operações concluídas: %d/3 - Prioridade: %d - Tentativas: %d\n",
@@ -682,6 +2451,15 @@ void gerar_relatorio_final() {
     safe_print("🔄 Em operação: %d\n", operando);
     safe_print("💥 Caídos: %d\n", avioes_caidos);
     safe_print("🛫 Arremeteram: %d\n", avioes_arremetidos);
+    safe_print("↪️ Desviados: %d\n", avioes_desviados);
+
+    safe_print("================================\n");
+    safe_print("🌀 DESFECHO DOS AVIÕES DO CIRCUITO DE ESPERA (%d):\n", avioes_circuito_total);
+    safe_print("✅  Finalizados: %d\n", circuito_finalizados);
+    safe_print("💥 Caídos: %d\n", circuito_caidos);
+    safe_print("🛫 Arremeteram: %d\n", circuito_arremetidos);
+    safe_print("↪️ Desviados: %d\n", circuito_desviados);
+    safe_print("⏳  Ainda em andamento: %d\n", circuito_em_andamento);
 
     int total_problemas = avioes_caidos + avioes_arremetidos;
     if (total_problemas == 0) {
@@ -693,28 +2471,101 @@ void gerar_relatorio_final() {
     }
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    const char* arquivo_salvar = NULL;
+    const char* arquivo_restaurar = NULL;
+    int salvar_em = -1;  // padrão: ao fim do tempo de simulação
+    FILE* roteiro_eventos = NULL;
+
+    // opções de linha de comando
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--duracao") == 0 && i + 1 < argc) {
+            duracao_simulacao = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--salvar-estado") == 0 && i + 1 < argc) {
+            arquivo_salvar = argv[++i];
+        } else if (strcmp(argv[i], "--salvar-em") == 0 && i + 1 < argc) {
+            salvar_em = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--restaurar") == 0 && i + 1 < argc) {
+            arquivo_restaurar = argv[++i];
+        } else if (strcmp(argv[i], "--eventos") == 0 && i + 1 < argc) {
+            const char* arquivo_eventos = argv[++i];
+            roteiro_eventos = (strcmp(arquivo_eventos, "-") == 0) ? stdin : fopen(arquivo_eventos, "r");
+            if (roteiro_eventos == NULL) {
+                fprintf(stderr, "Não foi possível abrir o roteiro de eventos %s\n", arquivo_eventos);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--planejador") == 0) {
+            planejador_ativo = 1;
+        } else if (strcmp(argv[i], "--sincronizacao") == 0 && i + 1 < argc &&
+                   (strcmp(argv[i + 1], "pthread") == 0 || strcmp(argv[i + 1], "futex") == 0)) {
+            sincronizacao_futex = (strcmp(argv[++i], "futex") == 0);
+            if (sincronizacao_futex && !SINCRONIZACAO_FUTEX) {
+                fprintf(stderr, "Sincronização futex indisponível nesta compilação (SINCRONIZACAO_FUTEX=0)\n");
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "Uso: %s [--planejador] [--sincronizacao pthread|futex] [--duracao SEG]\n"
+                            "          [--salvar-estado ARQ [--salvar-em SEG]] [--restaurar ARQ]\n"
+                            "          [--eventos ARQ|-]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (salvar_em < 0 || salvar_em > duracao_simulacao) {
+        salvar_em = duracao_simulacao;
+    }
+
     printf("🛫 Simulação de Controle de Tráfego Aéreo em Aeroporto Internacional");
     printf("\n\nConfiguração: %d Pistas, %d Portões, %d Operações Simultâneas na Torre\n",
            NUM_PISTAS, NUM_PORTOES, MAX_TORRE_OPERACOES);
-    printf("Tempo de Simulação: %d segundos\n", TEMPO_SIMULACAO);
+    printf("Tempo de Simulação: %d segundos\n", duracao_simulacao);
     printf("Tempo Crítico: %d segundos, Tempo para Queda: %d segundos\n",
            TEMPO_CRITICO, TEMPO_QUEDA);
-    printf("Máximo de tentativas por Avião: %d\n\n", MAX_TENTATIVAS);
+    printf("Máximo de tentativas por Avião: %d\n", MAX_TENTATIVAS);
+    printf("Política de alocação: %s\n",
+           planejador_ativo ? "planejador de reservas de slots" : "contenção por prioridade");
+    printf("Sincronização: %s\n\n",
+           sincronizacao_futex ? "spin + futex" : "pthread (mutex + variável de condição)");
 
     // inicializar recursos
     inicializar_recursos();
+    inicio_simulacao_ms = get_time_ms();
+    inicio_execucao_ms = inicio_simulacao_ms;
+    estado_rng = (unsigned int)time(NULL);
+
+    // retomar de um checkpoint (recria os aviões ativos e suas threads)
+    if (arquivo_restaurar != NULL && !restaurar_checkpoint(arquivo_restaurar)) {
+        return 1;
+    }
 
     // criar threads auxiliares
     pthread_t thread_criador, thread_monitor_id;
     pthread_create(&thread_criador, NULL, thread_criador_avioes, NULL);
     pthread_create(&thread_monitor_id, NULL, thread_monitor, NULL);
 
-    // aguardar tempo de simulação
-    sleep(TEMPO_SIMULACAO);
+    // eventos de capacidade (fechamento de pistas e portões, capacidade da torre)
+    if (roteiro_eventos != NULL) {
+        pthread_t thread_eventos_id;
+        pthread_create(&thread_eventos_id, NULL, thread_eventos, roteiro_eventos);
+        pthread_detach(thread_eventos_id);
+    }
+
+    // aguardar tempo de simulação, salvando o checkpoint no instante pedido
+    if (arquivo_salvar != NULL) {
+        sleep(salvar_em);
+        salvar_checkpoint(arquivo_salvar);
+        sleep(duracao_simulacao - salvar_em);
+    } else {
+        sleep(duracao_simulacao);
+    }
 
     // parar criação de novos aviões
     simulacao_ativa = 0;
+
+    // acordar aviões aguardando slots futuros do planejador
+    pthread_mutex_lock(&mutex_planejador);
+    pthread_cond_broadcast(&cond_planejador);
+    pthread_mutex_unlock(&mutex_planejador);
     safe_print("\n🛑 Tempo de simulação encerrado. Parando criação de novos aviões...\n");
 
     // aguardar threads auxiliares
@@ -733,6 +2584,7 @@ int main() {
     for (int i = 0; i < num_avioes; i++) {
         free(avioes[i]);
     }
+    free(avioes);
     pthread_mutex_unlock(&mutex_avioes);
 
     // destruir semáforos
@@ -750,10 +2602,13 @@ int main() {
     pthread_mutex_destroy(&mutex_stats);
     pthread_mutex_destroy(&mutex_critico);
     pthread_mutex_destroy(&mutex_avioes);
+    pthread_mutex_destroy(&mutex_admissao);
+    pthread_mutex_destroy(&mutex_planejador);
 
     // destruir condition variables
     pthread_cond_destroy(&cond_torre);
     pthread_cond_destroy(&cond_recursos);
+    pthread_cond_destroy(&cond_planejador);
 
     printf("\n🎯 Simulação concluída com sucesso!\n");
 